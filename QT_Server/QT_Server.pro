@@ -2,24 +2,29 @@ QT       += core gui multimedia
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets network concurrent
 
-CONFIG += c++11
+# 서버 코어 (네트워크/파싱/오디오 엔진). 헤드리스 실행 파일(headless/)과 같은 소스
+include(server_core.pri)
 
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    latencywidget.cpp \
     main.cpp \
     mainwidget.cpp \
     mixerwidget.cpp \
-    serverwidget.cpp \
-    tab1socketserver.cpp
+    recvlogmodel.cpp \
+    tab1socketserver.cpp \
+    tempowidget.cpp
 
 HEADERS += \
+    latencywidget.h \
     mainwidget.h \
     mixerwidget.h \
-    serverwidget.h \
-    tab1socketserver.h
+    recvlogmodel.h \
+    tab1socketserver.h \
+    tempowidget.h
 
 FORMS += \
     mainwidget.ui \
@@ -30,5 +35,9 @@ qnx: target.path = /tmp/$${TARGET}/bin
 else: unix:!android: target.path = /opt/$${TARGET}/bin
 !isEmpty(target.path): INSTALLS += target
 
-RESOURCES += \
-    wav.qrc
+# 샘플 뱅크에 없는 샘플을 디코딩할 WAV 폴더 (<실행파일 폴더>/samples)
+!isEmpty(target.path) {
+    samples.path = $${target.path}/samples
+    samples.files = $$SAMPLE_WAVS
+    INSTALLS += samples
+}
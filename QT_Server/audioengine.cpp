@@ -0,0 +1,429 @@
+#include "audioengine.h"
+#include "samplebank.h"
+#include "wavdecoder.h"
+
+#include <QAudioOutput>
+#include <QAudioDeviceInfo>
+#include <QCoreApplication>
+#include <QStringList>
+#include <QTimer>
+#include <QDebug>
+
+AudioEngine::AudioEngine(QObject *parent)
+    : QIODevice(parent)
+    , m_core(kSampleRate)
+{
+    static_assert(kChannels <= MixerCore::kMaxChannels, "too many mixer channels");
+    for (int ch = 0; ch <= kChannels; ++ch) {
+        m_levelPeak[ch].store(0.f, std::memory_order_relaxed);
+        m_levelRms[ch].store(0.f, std::memory_order_relaxed);
+    }
+    m_format.setSampleRate(kSampleRate);
+    m_format.setChannelCount(2);
+    m_format.setSampleSize(16);
+    m_format.setCodec(QStringLiteral("audio/pcm"));
+    m_format.setByteOrder(QAudioFormat::LittleEndian);
+    m_format.setSampleType(QAudioFormat::SignedInt);
+
+    const QString env = qEnvironmentVariable("QT_SERVER_AUDIO");
+    if (!env.isEmpty() && !setSink(env))
+        qWarning() << "[ENGINE] unknown QT_SERVER_AUDIO" << env << "-> device";
+}
+
+bool AudioEngine::setSink(const QString &spec)
+{
+    if (spec == QLatin1String("device")) {
+        m_sink = SinkDevice;
+    } else if (spec == QLatin1String("null")) {
+        m_sink = SinkNull;
+    } else if (spec.startsWith(QLatin1String("wav:")) && spec.size() > 4) {
+        m_sink = SinkWav;
+        m_wavPath = spec.mid(4);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+AudioEngine::~AudioEngine()
+{
+    stop();
+}
+
+bool AudioEngine::loadSamples()
+{
+    QElapsedTimer t;
+    t.start();
+    const QString appDir = QCoreApplication::applicationDirPath();
+    bool loaded[SAMPLE_COUNT] = {};
+    int count = 0;
+
+    QString bank = qEnvironmentVariable("QT_SERVER_SAMPLE_BANK");
+    if (bank.isEmpty()) bank = appDir + QStringLiteral("/samples.bank");
+    if (QFile::exists(bank)) {
+        count = loadSampleBank(bank, loaded);
+        if (count > 0)
+            qInfo() << "[ENGINE] sample bank mapped:" << bank << m_bankFile.size() << "bytes," << count << "samples";
+    } else {
+        qWarning() << "[ENGINE] no sample bank at" << bank << "-> build one with tools/mkbank";
+    }
+
+    // 뱅크에 없는 샘플만 WAV 로 채운다
+    QStringList dirs;
+    const QString wavDir = qEnvironmentVariable("QT_SERVER_WAV_DIR");
+    dirs << (wavDir.isEmpty() ? appDir + QStringLiteral("/samples") : wavDir);
+#ifdef QT_SERVER_EMBED_WAV
+    dirs << QStringLiteral(":/samples");
+#endif
+    for (const QString &dir : dirs) {
+        if (count == SAMPLE_COUNT) break;
+        const int n = loadWavFiles(dir, loaded);
+        if (n > 0) qInfo() << "[ENGINE]" << n << "samples decoded from" << dir;
+        count += n;
+    }
+
+    if (count == 0) {
+        qCritical() << "[ENGINE] no samples loaded (bank" << bank << ", wav" << dirs << ") - all notes will be silent";
+        return false;
+    }
+    if (count < SAMPLE_COUNT) {
+        for (int i = 0; i < SAMPLE_COUNT; ++i)
+            if (!loaded[i]) qWarning() << "[ENGINE] sample missing (silent):" << kSampleNames[i];
+    }
+    qInfo() << "[ENGINE] samples loaded" << count << "/" << SAMPLE_COUNT << "in" << t.elapsed() << "ms";
+    return count == SAMPLE_COUNT;
+}
+
+int AudioEngine::loadSampleBank(const QString &path, bool loaded[])
+{
+    m_bankFile.setFileName(path);
+    if (!m_bankFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "[ENGINE] bank open fail:" << path << m_bankFile.errorString();
+        return 0;
+    }
+    const qint64 size = m_bankFile.size();
+    const uchar *base = m_bankFile.map(0, size);   // 읽기 전용 공유 매핑 → 서버 여러 개가 페이지 공유
+    SampleBankView view;
+    std::string err;
+    if (!base || !view.open(base, size_t(size), &err)) {
+        qWarning() << "[ENGINE] bad sample bank:" << path << (base ? QString::fromStdString(err) : m_bankFile.errorString());
+        m_bankFile.close();
+        return 0;
+    }
+    if (view.sampleRate() != uint32_t(kSampleRate)) {
+        qWarning() << "[ENGINE] sample bank rate" << view.sampleRate() << "!=" << kSampleRate << "-> rebuild with mkbank -r";
+        m_bankFile.close();
+        return 0;
+    }
+
+    int found = 0;
+    for (int i = 0; i < SAMPLE_COUNT; ++i) {
+        const int idx = view.find(kSampleNames[i]);
+        if (idx < 0) { qWarning() << "[ENGINE] bank has no sample" << kSampleNames[i] << "-> WAV fallback"; continue; }
+        m_core.setSampleView(i, view.pcm(idx), view.frames(idx));
+        loaded[i] = true;
+        ++found;
+    }
+    if (found == 0) {
+        m_bankFile.close();
+        return 0;
+    }
+
+    // 첫 타격 때 오디오 스레드에서 페이지 폴트가 나지 않도록 미리 한 번씩 읽어 둔다
+    volatile uchar sink = 0;
+    for (qint64 off = 0; off < size; off += 4096) sink ^= base[off];
+    Q_UNUSED(sink);
+    return found;
+}
+
+int AudioEngine::loadWavFiles(const QString &dir, bool loaded[])
+{
+    int n = 0;
+    for (int i = 0; i < SAMPLE_COUNT; ++i) {
+        if (loaded[i]) continue;
+        const QString path = dir + QLatin1Char('/') + QLatin1String(kSampleNames[i]) + QStringLiteral(".wav");
+        QFile f(path);
+        if (!f.open(QIODevice::ReadOnly)) continue;   // 다음 폴더에서 찾는다 (끝까지 없으면 loadSamples 가 알림)
+        const QByteArray raw = f.readAll();
+        std::vector<int16_t> pcm;
+        std::string err;
+        if (!decodeWavToStereo16(raw.constData(), size_t(raw.size()), kSampleRate, pcm, &err)) {
+            qWarning() << "[ENGINE] decode fail:" << path << QString::fromStdString(err);
+            continue;
+        }
+        m_core.setSample(i, std::move(pcm));
+        loaded[i] = true;
+        ++n;
+    }
+    return n;
+}
+
+bool AudioEngine::start()
+{
+    if (m_output || m_nullTimer) return true;
+
+    if (m_sink == SinkWav) {
+        if (!openWavSink()) return false;
+        startTimerSink();
+        qInfo() << "[ENGINE] started on wav output" << m_wavPath;
+        return true;
+    }
+
+    QAudioDeviceInfo dev = QAudioDeviceInfo::defaultOutputDevice();
+    if (m_sink == SinkNull || dev.isNull() || !dev.isFormatSupported(m_format)) {
+        if (m_sink != SinkNull)
+            qWarning() << "[ENGINE] 48kHz/16bit/stereo not supported by" << dev.deviceName() << "-> null output";
+        startTimerSink();
+        qInfo() << "[ENGINE] started on null output (no audio device)";
+        return true;
+    }
+
+    open(QIODevice::ReadOnly);
+    m_output = new QAudioOutput(dev, m_format, this);
+    // 작은 버퍼 = 낮은 지연. 백엔드가 더 크게 잡을 수 있으므로 실제 값은 로그로 확인.
+    m_output->setBufferSize(m_format.bytesForDuration(qint64(kBufferMs) * 1000));
+    m_output->start(this);   // pull 모드
+    qInfo() << "[ENGINE] started on" << dev.deviceName()
+            << "buffer" << m_output->bufferSize() << "bytes";
+    return true;
+}
+
+void AudioEngine::stop()
+{
+    if (m_nullTimer) {
+        m_nullTimer->stop();
+        delete m_nullTimer;
+        m_nullTimer = nullptr;
+        closeWavSink();
+        close();
+    }
+    if (!m_output) return;
+    m_output->stop();
+    delete m_output;
+    m_output = nullptr;
+    close();
+}
+
+void AudioEngine::startTimerSink()
+{
+    open(QIODevice::ReadOnly);
+    m_nullFrames = 0;
+    m_nullClock.start();
+    m_nullTimer = new QTimer(this);
+    m_nullTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_nullTimer, &QTimer::timeout, this, &AudioEngine::onNullTick);
+    m_nullTimer->start(kBufferMs / 2);
+}
+
+// 길이 0 헤더로 열고 닫을 때 실제 길이로 고친다 (중간에 죽어도 대부분의 도구가 data 끝까지 읽는다)
+bool AudioEngine::openWavSink()
+{
+    m_wavFile.setFileName(m_wavPath);
+    if (!m_wavFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[ENGINE] wav output open failed:" << m_wavPath << m_wavFile.errorString();
+        return false;
+    }
+    unsigned char hdr[kWavHeaderBytes];
+    makeWavHeader16(hdr, kSampleRate, 0);
+    m_wavFile.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+    m_wavBytes = 0;
+    return true;
+}
+
+void AudioEngine::closeWavSink()
+{
+    if (!m_wavFile.isOpen()) return;
+    unsigned char hdr[kWavHeaderBytes];
+    makeWavHeader16(hdr, kSampleRate, quint32(qMin<qint64>(m_wavBytes, 0xFFFFFFFFLL)));
+    m_wavFile.seek(0);
+    m_wavFile.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+    m_wavFile.close();
+    qInfo() << "[ENGINE] wav output closed:" << m_wavPath
+            << m_wavBytes / 4 * 1000 / kSampleRate << "ms";
+}
+
+// null/wav 출력: 실제 장치처럼 실시간 속도로 블록을 당겨 간다 (wav 면 파일에 덧붙이고, null 이면 버린다)
+void AudioEngine::onNullTick()
+{
+    const qint64 due = (m_nullClock.nsecsElapsed() / 1000) * kSampleRate / 1000000;
+    while (m_nullFrames < due) {
+        const int n = int(qMin<qint64>(due - m_nullFrames, MixerCore::kBlockFrames));
+        const qint64 bytes = readData(reinterpret_cast<char*>(m_nullBlock), qint64(n) * 4);
+        if (m_wavFile.isOpen() && bytes > 0) {
+            if (m_wavFile.write(reinterpret_cast<const char*>(m_nullBlock), bytes) == bytes) {
+                m_wavBytes += bytes;
+            } else {
+                qWarning() << "[ENGINE] wav output write failed:" << m_wavFile.errorString() << "-> null output";
+                closeWavSink();
+            }
+        }
+        m_nullFrames += n;
+    }
+}
+
+bool AudioEngine::post(const NoteEvent &ev)
+{
+    if (!m_queue.push(ev)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_posted.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// 블록 시계: 이번 블록 첫 프레임이 렌더되는 시각. 콜백 호출 시각은 떨리므로 앞 블록에서 프레임 수만큼
+// 진행한 예측값을 실제 시각 쪽으로 1/16 씩만 당긴다 → 예약 이벤트 사이 간격이 프레임 단위로 고르게 유지된다.
+qint64 AudioEngine::blockClock(int frames)
+{
+    const qint64 now = monoNowNs();
+    const qint64 predicted = m_nextBlockNs;
+    const qint64 blockNs = (predicted == 0 || qAbs(now - predicted) > kClockResetNs)
+                         ? now : predicted + (now - predicted) / 16;
+    m_nextBlockNs = blockNs + qint64(frames) * 1000000000LL / kSampleRate;
+    return blockNs;
+}
+
+void AudioEngine::drainQueue(qint64 blockNs)
+{
+    const int depth = int(m_queue.size());
+    if (depth > m_depthMax.load(std::memory_order_relaxed))
+        m_depthMax.store(depth, std::memory_order_relaxed);
+    if (depth == 0) return;
+
+    const qint64 now = monoNowNs();
+    const qint64 devNs = outputQueuedNs();   // 이번 블록 앞에 이미 쌓여 있는 출력 분량
+    NoteEvent ev;
+    while (m_queue.pop(ev)) {
+        const qint64 wait = now - ev.rxNs;
+        m_waitLastNs.store(wait, std::memory_order_relaxed);
+        m_waitSumNs.fetch_add(wait, std::memory_order_relaxed);
+        if (wait > m_waitMaxNs.load(std::memory_order_relaxed))
+            m_waitMaxNs.store(wait, std::memory_order_relaxed);
+        m_consumed.fetch_add(1, std::memory_order_relaxed);
+
+        // 예약 없는 보이스는 이번 블록의 첫 프레임부터 울린다 (render 시각 = blockNs)
+        int delayFrames = 0;
+        if (ev.playNs > 0) {
+            const qint64 ahead = ev.playNs - blockNs;
+            if (ahead < 0) m_schedLate.fetch_add(1, std::memory_order_relaxed);
+            else delayFrames = int((ahead < kMaxScheduleNs ? ahead : kMaxScheduleNs) * kSampleRate / 1000000000LL);
+        }
+        const qint64 renderNs = blockNs + qint64(delayFrames) * 1000000000LL / kSampleRate;
+        m_core.trigger(int(ev.sample), ev.gain, int(ev.channel), delayFrames);
+
+        LatencySample ls;
+        ls.instrument     = ev.channel;
+        ls.us[LAT_PARSE]  = uint32_t(qMax<qint64>(0, ev.parseNs - ev.rxNs) / 1000);
+        ls.us[LAT_QUEUE]  = uint32_t(qMax<qint64>(0, ev.queueNs - ev.parseNs) / 1000);
+        ls.us[LAT_WAIT]   = uint32_t(qMax<qint64>(0, renderNs - ev.queueNs) / 1000);
+        ls.us[LAT_TOTAL]  = uint32_t(qMax<qint64>(0, renderNs - ev.rxNs) / 1000);
+        ls.us[LAT_DEVICE] = uint32_t(devNs / 1000);
+        if (!m_latency.push(ls))
+            m_latDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+qint64 AudioEngine::outputQueuedNs() const
+{
+    if (!m_output) return 0;
+    const int queued = m_output->bufferSize() - m_output->bytesFree();
+    return queued > 0 ? qint64(queued / 4) * 1000000000LL / kSampleRate : 0;
+}
+
+void AudioEngine::setChannelGain(int channel, float gain)
+{
+    if (channel < 0 || channel >= kChannels) return;
+    m_channels[channel].gain.store(qBound(0.f, gain, 1.f), std::memory_order_relaxed);
+}
+
+void AudioEngine::setChannelPan(int channel, float pan)
+{
+    if (channel < 0 || channel >= kChannels) return;
+    m_channels[channel].pan.store(qBound(-1.f, pan, 1.f), std::memory_order_relaxed);
+}
+
+void AudioEngine::setChannelMute(int channel, bool mute)
+{
+    if (channel < 0 || channel >= kChannels) return;
+    m_channels[channel].mute.store(mute, std::memory_order_relaxed);
+}
+
+// 오디오 스레드: 채널 원자값 → 믹서 버스 목표값 (바뀐 채널만 램프 시작)
+void AudioEngine::applyChannelState()
+{
+    for (int ch = 0; ch < kChannels; ++ch) {
+        const ChannelState &s = m_channels[ch];
+        const float gain = s.mute.load(std::memory_order_relaxed) ? 0.f : s.gain.load(std::memory_order_relaxed);
+        m_core.setChannel(ch, gain, s.pan.load(std::memory_order_relaxed));
+    }
+}
+
+EngineQueueStats AudioEngine::queueStats() const
+{
+    EngineQueueStats s;
+    s.posted     = m_posted.load(std::memory_order_relaxed);
+    s.dropped    = m_dropped.load(std::memory_order_relaxed);
+    s.consumed   = m_consumed.load(std::memory_order_relaxed);
+    s.depthNow   = int(m_queue.size());
+    s.depthMax   = m_depthMax.load(std::memory_order_relaxed);
+    s.waitLastUs = m_waitLastNs.load(std::memory_order_relaxed) / 1000;
+    s.waitMaxUs  = m_waitMaxNs.load(std::memory_order_relaxed) / 1000;
+    s.schedLate  = m_schedLate.load(std::memory_order_relaxed);
+    s.waitAvgUs  = s.consumed ? qint64(m_waitSumNs.load(std::memory_order_relaxed) / qint64(s.consumed)) / 1000 : 0;
+    return s;
+}
+
+qint64 AudioEngine::bytesAvailable() const
+{
+    // 항상 무음이라도 채워 줄 수 있으므로 버퍼 한 개 분량을 보고한다
+    return qint64(MixerCore::kBlockFrames) * 4 + QIODevice::bytesAvailable();
+}
+
+qint64 AudioEngine::readData(char *data, qint64 maxlen)
+{
+    const int frames = int(maxlen / 4);   // 스테레오 int16 = 4바이트/프레임
+    if (frames <= 0) return 0;
+    applyChannelState();
+    drainQueue(blockClock(frames));
+    m_core.render(reinterpret_cast<int16_t*>(data), frames);
+    m_meterFrames += frames;
+    if (m_meterFrames >= kSampleRate / kMeterHz) publishLevels();
+    return qint64(frames) * 4;
+}
+
+// 믹서가 블록마다 누적한 peak/제곱합을 ~30Hz 로 원자값에 옮긴다 (오디오 스레드, 할당/잠금 없음)
+void AudioEngine::publishLevels()
+{
+    MixerCore::Levels lv;
+    m_core.takeLevels(lv);
+    m_meterFrames = 0;
+    for (int ch = 0; ch < kChannels; ++ch) {
+        m_levelPeak[ch].store(lv.peak[ch], std::memory_order_relaxed);
+        m_levelRms[ch].store(lv.rms[ch], std::memory_order_relaxed);
+    }
+    m_levelPeak[kChannels].store(lv.peak[MixerCore::kMasterMeter], std::memory_order_relaxed);
+    m_levelRms[kChannels].store(lv.rms[MixerCore::kMasterMeter], std::memory_order_relaxed);
+    if (lv.clipped) m_levelClipped.fetch_add(lv.clipped, std::memory_order_relaxed);
+    m_levelSerial.fetch_add(1, std::memory_order_release);
+}
+
+EngineLevels AudioEngine::levels() const
+{
+    EngineLevels l;
+    l.serial = m_levelSerial.load(std::memory_order_acquire);
+    for (int ch = 0; ch < kChannels; ++ch) {
+        l.peak[ch] = m_levelPeak[ch].load(std::memory_order_relaxed);
+        l.rms[ch]  = m_levelRms[ch].load(std::memory_order_relaxed);
+    }
+    l.masterPeak = m_levelPeak[kChannels].load(std::memory_order_relaxed);
+    l.masterRms  = m_levelRms[kChannels].load(std::memory_order_relaxed);
+    l.clipped    = m_levelClipped.load(std::memory_order_relaxed);
+    return l;
+}
+
+qint64 AudioEngine::writeData(const char *data, qint64 len)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(len);
+    return 0;
+}
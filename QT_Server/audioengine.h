@@ -0,0 +1,177 @@
+#ifndef AUDIOENGINE_H
+#define AUDIOENGINE_H
+
+#include <QIODevice>
+#include <QAudioFormat>
+#include <QFile>
+#include <QElapsedTimer>
+#include <atomic>
+
+#include "band_protocol.h"
+#include "latencystats.h"
+#include "mixercore.h"
+#include "noteevent.h"
+#include "samplemap.h"
+#include "spscring.h"
+
+class QAudioOutput;
+class QTimer;
+
+// 이벤트 큐 계측값 (UI/로그용 스냅샷)
+struct EngineQueueStats {
+    quint64 posted   = 0;   // post() 성공
+    quint64 dropped  = 0;   // 큐가 가득 차서 버린 이벤트
+    quint64 consumed = 0;   // 렌더 스레드가 꺼낸 이벤트
+    int     depthNow = 0;
+    int     depthMax = 0;
+    qint64  waitLastUs = 0; // 수신 → 렌더 스레드가 꺼낼 때까지
+    qint64  waitMaxUs  = 0;
+    qint64  waitAvgUs  = 0;
+    quint64 schedLate  = 0; // 예약 시각(playNs)이 이미 지나 늦게 울린 이벤트
+};
+
+// 레벨 미터 스냅샷 (full scale = 1.0). 오디오 스레드가 kMeterHz 주기로 갱신한다.
+struct EngineLevels {
+    float   peak[BAND_INST_COUNT] = {};   // 채널 버스 (게인/뮤트 적용 후)
+    float   rms[BAND_INST_COUNT]  = {};
+    float   masterPeak = 0.f;             // 클리핑 전 값. 1.0 이상이면 그 구간에 클리핑
+    float   masterRms  = 0.f;
+    quint64 clipped    = 0;               // 엔진 시작 이후 int16 로 잘린 샘플 수 (누적)
+    quint32 serial     = 0;               // 갱신마다 +1 (출력이 멈췄는지 판단용)
+};
+
+// 믹서 채널 상태 (악기 번호로 인덱스). 어느 스레드에서 써도 되고 오디오 스레드가 블록마다 읽는다.
+struct ChannelState {
+    std::atomic<float> gain{1.f};   // 0.0~1.0
+    std::atomic<float> pan{0.f};    // -1.0~+1.0
+    std::atomic<bool>  mute{false};
+};
+
+// 단일 출력 스트림 + 보이스 풀 믹서.
+// QAudioOutput 이 pull 모드로 readData() 를 호출하면 MixerCore 가 그 자리에서 믹스한다.
+// QSoundEffect 처럼 노트마다 백엔드 스트림을 열지 않으므로 트리거 비용 = 보이스 1개 할당.
+//
+// 엔진은 전용 오디오 스레드로 moveToThread 해서 쓴다. 소켓 쪽은 post() 로 SPSC 큐에
+// 이벤트만 넣고, readData() 가 매 콜백 시작 시 큐를 비운다. GUI 가 멈춰도 타격음은 지연되지 않는다.
+class AudioEngine : public QIODevice
+{
+    Q_OBJECT
+public:
+    static const int kSampleRate = 48000;
+    static const int kBufferMs   = 20;     // 출력 버퍼 목표 길이
+    static const size_t kQueueSize = 256;
+    static const int kChannels   = BAND_INST_COUNT;
+    static const size_t kLatencyQueueSize = 1024;
+    static const qint64 kMaxScheduleNs  = 2000000000LL;   // 예약 재생 최대 선행 시간
+    static const qint64 kClockResetNs   = 20000000LL;     // 블록 시계가 이만큼 어긋나면 다시 맞춤
+    static const int kMeterHz    = 30;     // 레벨 미터 갱신 주기
+
+    // 출력 싱크. 기본은 $QT_SERVER_AUDIO (없으면 device)
+    enum Sink {
+        SinkDevice,   // 기본 출력 장치 (없거나 포맷 미지원이면 null 로 대체)
+        SinkNull,     // 실시간 타이머로 렌더만 하고 버림 (오디오 하드웨어 없는 부하 테스트용)
+        SinkWav,      // null 과 같은 실시간 렌더 + 믹스 결과를 WAV 파일로 스트리밍
+    };
+
+    explicit AudioEngine(QObject *parent = nullptr);
+    ~AudioEngine() override;
+
+    // "device" | "null" | "wav:<path>". start 전에 호출. 모르는 값이면 false (그대로 유지)
+    bool setSink(const QString &spec);
+    Sink sink() const { return m_sink; }
+
+    // 샘플 로드 (1회, start 전에).
+    //  1) 샘플 뱅크 mmap : $QT_SERVER_SAMPLE_BANK 또는 <실행파일 폴더>/samples.bank (tools/mkbank 로 생성)
+    //  2) 뱅크에 없는 샘플만 WAV 디코딩 : $QT_SERVER_WAV_DIR 또는 <실행파일 폴더>/samples/<이름>.wav,
+    //     CONFIG+=embed_wav 로 빌드했으면 마지막으로 :/samples/<이름>.wav
+    // 전부 올리면 true. 하나도 못 올리면 qCritical 을 남기고 false.
+    bool loadSamples();
+
+    // 노트 재생 요청. 생산자(소켓 처리 스레드) 하나에서만 호출할 것.
+    // ev.playNs 를 주면 블록 시계로 환산해 그 프레임부터 울린다 (샘플 단위 예약).
+    bool post(const NoteEvent &ev);
+
+    EngineQueueStats queueStats() const;
+
+    // 레벨 미터 (어느 스레드에서나, 잠금 없음). 값마다 원자값이라 채널 사이가 한 주기 어긋날 수 있다.
+    EngineLevels levels() const;
+
+    // 이벤트별 지연 측정값 (오디오 스레드 → 소비자 1개, 보통 지연 탭의 GUI 타이머)
+    bool popLatency(LatencySample &out) { return m_latency.pop(out); }
+    quint64 latencyDropped() const { return m_latDropped.load(std::memory_order_relaxed); }
+
+    // 채널 상태 (GUI/네트워크 어느 스레드에서나). 렌더러가 다음 콜백에서 게인 램프로 반영한다.
+    void setChannelGain(int channel, float gain);
+    void setChannelPan(int channel, float pan);
+    void setChannelMute(int channel, bool mute);
+    bool channelMuted(int channel) const {
+        return channel >= 0 && channel < kChannels && m_channels[channel].mute.load(std::memory_order_relaxed);
+    }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override;
+
+public slots:
+    // 엔진 스레드에서 호출 (invokeMethod). 싱크가 null/wav 거나 출력 장치를 쓸 수 없으면
+    // 실시간 타이머로 readData 를 당기는 타이머 경로로 돈다.
+    bool start();
+    void stop();
+
+private slots:
+    void onNullTick();
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override;
+    qint64 writeData(const char *data, qint64 len) override;
+
+private:
+    void drainQueue(qint64 blockNs);
+    qint64 blockClock(int frames);
+    void applyChannelState();
+    void publishLevels();
+    void startTimerSink();
+    bool openWavSink();
+    void closeWavSink();
+    qint64 outputQueuedNs() const;
+    int loadSampleBank(const QString &path, bool loaded[]);   // 올린 샘플 수, loaded[i] 표시
+    int loadWavFiles(const QString &dir, bool loaded[]);      // 아직 없는 샘플만
+
+    MixerCore     m_core;
+    ChannelState  m_channels[kChannels];
+    QAudioOutput *m_output = nullptr;
+    QAudioFormat  m_format;
+    Sink          m_sink = SinkDevice;
+    QString       m_wavPath;
+    QFile         m_wavFile;               // wav 싱크 (오디오 스레드 전용)
+    qint64        m_wavBytes = 0;
+    QTimer       *m_nullTimer = nullptr;   // null/wav 출력: 경과 시간만큼 readData 호출
+    QElapsedTimer m_nullClock;
+    qint64        m_nullFrames = 0;
+    int16_t       m_nullBlock[MixerCore::kBlockFrames * 2];   // null/wav 틱에서 readData 가 채우는 블록
+    qint64        m_nextBlockNs = 0;       // 다음 블록 첫 프레임의 렌더 시각 추정 (오디오 스레드 전용)
+    QFile         m_bankFile;              // 매핑이 살아 있는 동안 열어 둔다 (MixerCore 가 참조)
+
+    SpscRing<NoteEvent, kQueueSize> m_queue;
+    SpscRing<LatencySample, kLatencyQueueSize> m_latency;
+    std::atomic<quint64> m_latDropped{0};
+
+    // 생산자 쪽 카운터
+    std::atomic<quint64> m_posted{0};
+    std::atomic<quint64> m_dropped{0};
+    // 소비자(오디오 스레드) 쪽 카운터
+    std::atomic<quint64> m_consumed{0};
+    std::atomic<int>     m_depthMax{0};
+    std::atomic<qint64>  m_waitLastNs{0};
+    std::atomic<qint64>  m_waitMaxNs{0};
+    std::atomic<qint64>  m_waitSumNs{0};
+    std::atomic<quint64> m_schedLate{0};
+
+    // 레벨 미터 (오디오 스레드가 씀, [kChannels] = 마스터)
+    int                  m_meterFrames = 0;
+    std::atomic<float>   m_levelPeak[kChannels + 1];
+    std::atomic<float>   m_levelRms[kChannels + 1];
+    std::atomic<quint64> m_levelClipped{0};
+    std::atomic<quint32> m_levelSerial{0};
+};
+
+#endif // AUDIOENGINE_H
@@ -0,0 +1,144 @@
+// 명령 파서 마이크로벤치마크: 예전 파서(QString/정규식/remove) vs cmdparser.h (읽기 커서, 무할당)
+//
+// 사용법: parserbench [recorded_burst.txt] [chunkBytes]
+//   - 파일을 주면 그 내용을 그대로(수신 바이트 스트림) 사용, 없으면 20만 줄 합성
+//   - chunkBytes 단위로 잘라 readyRead 한 번에 들어오는 묶음을 흉내 낸다 (기본 65536)
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QByteArray>
+#include <QString>
+#include <cstdio>
+#include <cstring>
+
+#include "cmdparser.h"
+
+static QByteArray synthBurst(int lines)
+{
+    static const char *notes = "CDEFGAB";
+    static const char *guita = "GDC";
+    QByteArray out;
+    out.reserve(lines * 10);
+    for (int i = 0; i < lines; ++i) {
+        switch (i % 3) {
+        case 0: out += "[DRUM]" + QByteArray::number(i % 5) + "\n"; break;
+        case 1: out += QByteArray("[PIANO]") + notes[i % 7] + "\n"; break;
+        default: out += QByteArray("GUITA:") + guita[i % 3] + "\r\n"; break;
+        }
+    }
+    return out;
+}
+
+// ---- 예전 경로 (ServerWidget::onReadyRead + handleLine 의 파싱 부분) ----
+static int legacyDispatch(const QByteArray &lineBA)
+{
+    const QString s = QString::fromUtf8(lineBA).trimmed();
+    if (s.isEmpty()) return -1;
+    QString tag, payload;
+    static const QRegularExpression reBracket(
+        R"(^\s*\[\s*([A-Za-z0-9_]+)\s*\]\s*(.*?)\s*$)"
+    );
+    auto m = reBracket.match(s);
+    if (m.hasMatch()) {
+        tag = m.captured(1).toUpper();
+        payload = m.captured(2);
+    } else {
+        const int p2 = s.indexOf(':');
+        if (p2 < 0) return -1;
+        tag = s.left(p2).trimmed().toUpper();
+        payload = s.mid(p2+1);
+    }
+    if (tag == "PIANO") return 0;
+    if (tag == "DRUM")  return 1;
+    if (tag == "GUITA") return 2;
+    return -1;
+}
+
+static long legacyFeed(QByteArray &rxBuf, const QByteArray &chunk, long hits[3])
+{
+    long lines = 0;
+    rxBuf += chunk;
+    while (true) {
+        int pos = rxBuf.indexOf('\n');
+        if (pos < 0) break;
+        const int len = pos + 1;
+        QByteArray rawLine = rxBuf.left(len);
+        QByteArray line = rawLine;
+        if (!line.isEmpty() && line.endsWith('\n')) line.chop(1);
+        if (!line.isEmpty() && line.endsWith('\r')) line.chop(1);
+        const int t = legacyDispatch(line);
+        if (t >= 0) ++hits[t];
+        ++lines;
+        rxBuf.remove(0, len);
+    }
+    return lines;
+}
+
+// ---- 새 경로 (NetServer::onReadyRead + handleLine) ----
+static const struct { const char *name; int len; } kTags[] = {
+    { "PIANO", 5 }, { "DRUM", 4 }, { "GUITA", 5 },
+};
+
+static long cursorFeed(QByteArray &rxBuf, const QByteArray &chunk, long hits[3])
+{
+    long lines = 0;
+    const int old = rxBuf.size();
+    rxBuf.resize(old + chunk.size());
+    memcpy(rxBuf.data() + old, chunk.constData(), size_t(chunk.size()));
+
+    const char *base = rxBuf.constData();
+    const int size = rxBuf.size();
+    int pos = 0;
+    while (pos < size) {
+        const char *nl = static_cast<const char*>(memchr(base + pos, '\n', size_t(size - pos)));
+        if (!nl) break;
+        const int end = int(nl - base);
+        int lineEnd = end;
+        if (lineEnd > pos && base[lineEnd - 1] == '\r') --lineEnd;
+        CmdView cmd;
+        if (parseCommand(base + pos, lineEnd - pos, cmd)) {
+            for (int t = 0; t < 3; ++t)
+                if (cmdTagEquals(cmd.tag, cmd.tagLen, kTags[t].name, kTags[t].len)) { ++hits[t]; break; }
+        }
+        ++lines;
+        pos = end + 1;
+    }
+    if (pos > 0) rxBuf.remove(0, pos);
+    return lines;
+}
+
+template <typename Feed>
+static void run(const char *name, const QByteArray &burst, int chunkBytes, Feed feed)
+{
+    long hits[3] = {0, 0, 0};
+    long lines = 0;
+    QByteArray rxBuf;
+    QElapsedTimer t; t.start();
+    for (int off = 0; off < burst.size(); off += chunkBytes)
+        lines += feed(rxBuf, burst.mid(off, chunkBytes), hits);
+    const double sec = t.nsecsElapsed() / 1e9;
+    printf("%-8s lines=%ld  piano=%ld drum=%ld guita=%ld  %.3f s  %.0f lines/s\n",
+           name, lines, hits[0], hits[1], hits[2], sec, sec > 0 ? lines / sec : 0.0);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QByteArray burst;
+    if (argc >= 2) {
+        QFile f(QString::fromLocal8Bit(argv[1]));
+        if (!f.open(QIODevice::ReadOnly)) { fprintf(stderr, "cannot open %s\n", argv[1]); return 1; }
+        burst = f.readAll();
+    } else {
+        burst = synthBurst(200000);
+    }
+    const int chunkBytes = (argc >= 3) ? qMax(1, atoi(argv[2])) : 65536;
+
+    printf("burst %d bytes, chunk %d bytes\n", burst.size(), chunkBytes);
+    run("legacy", burst, chunkBytes, legacyFeed);
+    run("cursor", burst, chunkBytes, cursorFeed);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#ifndef CMDPARSER_H
+#define CMDPARSER_H
+
+#include <cstddef>
+
+// 명령 라인 파서 (Qt 비의존, 힙 할당 없음).
+// 수신 버퍼 안의 바이트를 그대로 가리키는 뷰만 만든다.
+//   "[TAG]payload"  /  "TAG:payload"   (앞뒤 공백 허용, TAG 는 [A-Za-z0-9_]+)
+struct CmdView {
+    const char *tag = nullptr;
+    int         tagLen = 0;
+    const char *payload = nullptr;
+    int         payloadLen = 0;
+};
+
+static inline bool cmdIsSpace(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == '\v' || ch == '\f';
+}
+static inline bool cmdIsTagChar(char ch) {
+    return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '_';
+}
+static inline char cmdUpper(char ch) {
+    return (ch >= 'a' && ch <= 'z') ? char(ch - 'a' + 'A') : ch;
+}
+
+// [b, e) 앞뒤 공백 제거
+static inline void cmdTrim(const char *&b, const char *&e) {
+    while (b < e && cmdIsSpace(*b)) ++b;
+    while (e > b && cmdIsSpace(e[-1])) --e;
+}
+
+// line[0..len) 을 파싱. 인식하지 못하면 false.
+static inline bool parseCommand(const char *line, int len, CmdView &out)
+{
+    const char *b = line, *e = line + len;
+    cmdTrim(b, e);
+    if (b == e) return false;
+
+    if (*b == '[') {
+        const char *p = b + 1;
+        while (p < e && cmdIsSpace(*p)) ++p;
+        const char *t0 = p;
+        while (p < e && cmdIsTagChar(*p)) ++p;
+        const char *t1 = p;
+        while (p < e && cmdIsSpace(*p)) ++p;
+        if (t1 > t0 && p < e && *p == ']') {
+            const char *pb = p + 1, *pe = e;
+            cmdTrim(pb, pe);
+            out.tag = t0; out.tagLen = int(t1 - t0);
+            out.payload = pb; out.payloadLen = int(pe - pb);
+            return true;
+        }
+        // 괄호 형식이 아니면 콜론 형식으로 재시도
+    }
+
+    const char *colon = b;
+    while (colon < e && *colon != ':') ++colon;
+    if (colon == e) return false;
+
+    const char *tb = b, *te = colon;
+    cmdTrim(tb, te);
+    const char *pb = colon + 1, *pe = e;
+    cmdTrim(pb, pe);
+    out.tag = tb; out.tagLen = int(te - tb);
+    out.payload = pb; out.payloadLen = int(pe - pb);
+    return true;
+}
+
+// 대소문자 무시 비교 (name 은 대문자 상수)
+static inline bool cmdTagEquals(const char *tag, int len, const char *name, int nameLen) {
+    if (len != nameLen) return false;
+    for (int i = 0; i < len; ++i)
+        if (cmdUpper(tag[i]) != name[i]) return false;
+    return true;
+}
+
+// 부호 없는 10진 정수 (앞뒤 공백은 호출 전에 제거되어 있어야 함)
+static inline bool cmdParseUInt(const char *p, int len, int &out) {
+    if (len <= 0 || len > 9) return false;
+    int v = 0;
+    for (int i = 0; i < len; ++i) {
+        if (p[i] < '0' || p[i] > '9') return false;
+        v = v * 10 + (p[i] - '0');
+    }
+    out = v;
+    return true;
+}
+
+#endif // CMDPARSER_H
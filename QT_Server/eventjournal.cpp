@@ -0,0 +1,173 @@
+#include "eventjournal.h"
+#include "noteevent.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+bool EventJournal::open(const std::string &prefix, uint32_t maxSegments, std::string *err)
+{
+    close();
+    m_prefix      = prefix;
+    m_maxSegments = maxSegments > 0 ? maxSegments : 1;
+    m_opened  = 0;
+    m_written = 0;
+    m_failed  = 0;
+    m_full    = false;
+    m_prepFailed.store(false);
+
+    Segment *s = createSegment(prefix, 0, err);
+    if (!s) return false;
+    activate(s);
+
+    m_running.store(true, std::memory_order_release);
+    m_prep = std::thread(&EventJournal::prepLoop, this);
+    return true;
+}
+
+void EventJournal::close()
+{
+    if (m_prep.joinable()) {
+        m_running.store(false, std::memory_order_release);
+        m_prep.join();
+    }
+    retireCurrent();
+    if (Segment *r = m_retired.exchange(nullptr)) finishSegment(r, true);
+    if (Segment *s = m_spare.exchange(nullptr)) finishSegment(s, false);   // 안 쓴 예비 세그먼트는 지운다
+}
+
+// 준비 스레드에서 (첫 세그먼트만 open 에서). 네트워크 스레드의 쓰기 경로에서는 부르지 않는다.
+EventJournal::Segment *EventJournal::createSegment(const std::string &prefix, uint32_t index, std::string *err)
+{
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "-%03u.bandj", index);
+    const std::string path = prefix + suffix;
+
+    const size_t bytes = size_t(segmentBytes());
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        if (err) *err = path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+    // 블록을 실제로 잡아 둔다 (ftruncate 만 하면 sparse 라 첫 쓰기마다 블록 할당 + 디스크 가득 시 SIGBUS)
+    int rc = ::posix_fallocate(fd, 0, off_t(bytes));
+    if (rc == EOPNOTSUPP || rc == EINVAL)   // 지원하지 않는 파일시스템 → 크기만 맞춘다
+        rc = ::ftruncate(fd, off_t(bytes)) == 0 ? 0 : errno;
+    if (rc != 0) {
+        if (err) *err = path + ": fallocate " + std::strerror(rc);
+        ::close(fd);
+        ::unlink(path.c_str());
+        return nullptr;
+    }
+    void *base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (base == MAP_FAILED) {
+        if (err) *err = path + ": mmap " + std::strerror(errno);
+        ::close(fd);
+        ::unlink(path.c_str());
+        return nullptr;
+    }
+    // 페이지마다 한 번 써서 쓰기 가능한 매핑으로 만들어 둔다 (append 에서 쓰기 폴트가 나지 않게)
+    volatile unsigned char *p = static_cast<unsigned char*>(base);
+    for (size_t off = 0; off < bytes; off += 4096) p[off] = 0;
+
+    JournalHeader *h = static_cast<JournalHeader*>(base);
+    std::memset(h, 0, sizeof(*h));
+    std::memcpy(h->magic, kJournalMagic, sizeof(h->magic));
+    h->version    = kJournalVersion;
+    h->recordSize = sizeof(JournalRecord);
+    h->capacity   = kSegmentRecords;
+    h->segment    = index;
+
+    Segment *s = new Segment;
+    s->path  = path;
+    s->fd    = fd;
+    s->bytes = bytes;
+    s->hdr   = h;
+    s->index = index;
+    return s;
+}
+
+// 사용한 만큼만 남기고 닫는다 (읽는 쪽은 잘린 파일도 count 로 판단). keep=false 면 파일을 지운다
+void EventJournal::finishSegment(Segment *s, bool keep)
+{
+    const off_t used = off_t(sizeof(JournalHeader) + s->hdr->count * sizeof(JournalRecord));
+    ::munmap(s->hdr, s->bytes);
+    if (keep && ::ftruncate(s->fd, used) != 0)
+        std::fprintf(stderr, "[JOURNAL] truncate fail %s: %s\n", s->path.c_str(), std::strerror(errno));
+    ::close(s->fd);
+    if (!keep) ::unlink(s->path.c_str());
+    delete s;
+}
+
+// 세그먼트를 쓰기 시작하는 순간의 시각을 찍고 쓰기 포인터를 옮긴다 (네트워크 스레드, 시스템 콜은 vDSO 시계뿐)
+void EventJournal::activate(Segment *s)
+{
+    JournalHeader *h = s->hdr;
+    h->startMonoNs = monoNowNs();
+    timespec ts;
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+    h->startWallMs = int64_t(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+
+    m_cur  = s;
+    m_hdr  = h;
+    m_recs = reinterpret_cast<JournalRecord*>(h + 1);
+    ++m_opened;
+}
+
+// 현재 세그먼트를 준비 스레드로 넘긴다. 앞에 넘긴 것이 아직 남아 있으면 (준비 스레드가 멈춘 경우) 여기서 닫는다
+void EventJournal::retireCurrent()
+{
+    if (!m_cur) return;
+    m_lastPath = m_cur->path;
+    Segment *prev = m_retired.exchange(m_cur, std::memory_order_acq_rel);
+    if (prev) finishSegment(prev, true);
+    if (!m_prep.joinable()) finishSegment(m_retired.exchange(nullptr), true);
+    m_cur  = nullptr;
+    m_hdr  = nullptr;
+    m_recs = nullptr;
+}
+
+// 세그먼트가 찼을 때만 들어오는 경로. 준비된 예비 세그먼트와 포인터만 바꾼다
+void EventJournal::appendRolled(const JournalRecord &rec)
+{
+    Segment *next = m_spare.exchange(nullptr, std::memory_order_acq_rel);
+    if (!next) {
+        if (m_cur->index + 1 >= m_maxSegments) {
+            std::fprintf(stderr, "[JOURNAL] size cap reached (%u segments), journal stopped\n", m_maxSegments);
+            retireCurrent();
+            m_full = true;
+        }
+        ++m_failed;   // 예비 세그먼트가 아직 없음 → 이 레코드는 버리고 다음 append 에서 다시 시도
+        return;
+    }
+    retireCurrent();
+    activate(next);
+    append(rec);
+}
+
+void EventJournal::prepLoop()
+{
+    uint32_t nextIndex = 1;
+    while (m_running.load(std::memory_order_acquire)) {
+        if (Segment *r = m_retired.exchange(nullptr, std::memory_order_acq_rel))
+            finishSegment(r, true);
+        if (!m_spare.load(std::memory_order_acquire) && nextIndex < m_maxSegments
+            && !m_prepFailed.load(std::memory_order_relaxed)) {
+            std::string err;
+            if (Segment *s = createSegment(m_prefix, nextIndex, &err)) {
+                m_spare.store(s, std::memory_order_release);
+                ++nextIndex;
+            } else {
+                std::fprintf(stderr, "[JOURNAL] next segment prepare fail, journal will stop when full: %s\n", err.c_str());
+                m_prepFailed.store(true, std::memory_order_relaxed);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kPrepIdleMs));
+    }
+}
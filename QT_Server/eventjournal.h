@@ -0,0 +1,88 @@
+#ifndef EVENTJOURNAL_H
+#define EVENTJOURNAL_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "journalformat.h"
+
+// 수락한 노트 이벤트의 append-only 저널 (Qt 비의존, append 는 네트워크 스레드 전용).
+// 세그먼트 파일을 kSegmentRecords 개 크기로 미리 할당(posix_fallocate)하고 mmap 한 뒤 페이지를 한 번씩 써 둔다.
+// append() 는 레코드 40바이트 memcpy + header.count 증가만 한다 (시스템 콜/할당 없음).
+//
+// 세그먼트 준비/정리는 준비 스레드가 한다:
+//   - 다음 세그먼트를 미리 만들어 m_spare 에 올려 두고, 세그먼트가 차면 append 가 포인터 교환으로 바꿔 낀다
+//   - 다 쓴 세그먼트는 m_retired 로 넘기면 준비 스레드가 잘라내고(ftruncate) 닫는다
+// 예비 세그먼트가 아직 없거나 maxSegments 에 닿으면 그 레코드는 버리고 failed() 로 센다 (네트워크 스레드는 막지 않는다).
+class EventJournal
+{
+public:
+    static const uint64_t kSegmentRecords = 262144;   // 40 B x 256k = 10 MB
+    static const int      kPrepIdleMs     = 20;       // 준비 스레드 폴링 주기
+    static uint64_t segmentBytes() { return sizeof(JournalHeader) + kSegmentRecords * sizeof(JournalRecord); }
+
+    EventJournal() = default;
+    ~EventJournal() { close(); }
+    EventJournal(const EventJournal &) = delete;
+    EventJournal &operator=(const EventJournal &) = delete;
+
+    // prefix-000.bandj 부터 연다 (디렉터리는 있어야 함). 세그먼트는 최대 maxSegments 개 (총 크기 상한)
+    bool open(const std::string &prefix, uint32_t maxSegments, std::string *err = nullptr);
+    void close();
+    bool isOpen() const { return m_hdr != nullptr; }
+
+    void append(const JournalRecord &rec)
+    {
+        if (!m_hdr) { if (m_full) ++m_failed; return; }
+        const uint64_t n = m_hdr->count;
+        if (n == m_hdr->capacity) { appendRolled(rec); return; }
+        m_recs[n] = rec;
+        __atomic_store_n(&m_hdr->count, n + 1, __ATOMIC_RELEASE);   // 따라 읽는 쪽은 count 까지만 본다
+        ++m_written;
+    }
+
+    uint64_t written() const  { return m_written; }
+    uint64_t failed() const   { return m_failed; }
+    uint32_t segments() const { return m_opened; }
+    const std::string &path() const { return m_cur ? m_cur->path : m_lastPath; }
+
+private:
+    struct Segment {
+        std::string    path;
+        int            fd = -1;
+        size_t         bytes = 0;
+        JournalHeader *hdr = nullptr;
+        uint32_t       index = 0;
+    };
+
+    static Segment *createSegment(const std::string &prefix, uint32_t index, std::string *err);
+    static void finishSegment(Segment *s, bool keep);
+    void activate(Segment *s);
+    void retireCurrent();
+    void appendRolled(const JournalRecord &rec);
+    void prepLoop();
+
+    std::string    m_prefix;
+    uint32_t       m_maxSegments = 0;
+
+    // 네트워크 스레드 전용
+    Segment       *m_cur = nullptr;
+    JournalHeader *m_hdr = nullptr;
+    JournalRecord *m_recs = nullptr;
+    std::string    m_lastPath;
+    uint32_t       m_opened = 0;
+    uint64_t       m_written = 0;
+    uint64_t       m_failed = 0;        // 세그먼트를 못 바꿔 끼워(준비 안 됨/상한/오류) 버린 레코드
+    bool           m_full = false;      // maxSegments 에 닿아 기록을 멈춤
+
+    // 준비 스레드 ↔ 네트워크 스레드
+    std::thread            m_prep;
+    std::atomic<bool>      m_running{false};
+    std::atomic<Segment*>  m_spare{nullptr};     // 준비 스레드가 만든 다음 세그먼트
+    std::atomic<Segment*>  m_retired{nullptr};   // 네트워크 스레드가 넘긴 다 쓴 세그먼트
+    std::atomic<bool>      m_prepFailed{false};  // 다음 세그먼트를 못 만듦 (디스크 가득 등)
+};
+
+#endif // EVENTJOURNAL_H
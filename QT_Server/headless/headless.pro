@@ -0,0 +1,11 @@
+# 헤드리스 서버: 위젯 없이 ServerCore 만 띄운다 (QCoreApplication, 서버/CI/부하 테스트용)
+QT -= gui
+CONFIG += console
+CONFIG -= app_bundle
+
+TARGET = QT_Server_headless
+
+include(../server_core.pri)
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,98 @@
+// 헤드리스 서버: GUI 없이 서버 코어(네트워크 + 오디오 엔진)만 띄우고 바로 리슨한다.
+//
+//   QT_Server_headless [-p port] [-a device|null|wav:<path>]
+//
+//   -p, --port   TCP/UDP 포트 (기본 5000)
+//   -a, --audio  출력 싱크. device = 기본 장치 (없으면 null), null = 렌더만 하고 버림,
+//                wav:<path> = 실시간으로 렌더한 믹스를 WAV 파일로 기록 (종료 시 헤더 길이 확정)
+//                기본값은 $QT_SERVER_AUDIO, 그것도 없으면 device
+//
+// 템포/지터 설정은 위젯 앱과 같은 QSettings 에서 읽는다. 클라이언트 통계는 [CLIENTS] 로그로 나간다.
+// SIGINT/SIGTERM 을 받으면 stopServer → 저널/wav 를 정상적으로 닫고 끝난다.
+
+#include "servercore.h"
+#include "serverlog.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QDebug>
+
+#include <csignal>
+#include <unistd.h>
+
+static int g_sigFd[2] = { -1, -1 };
+
+static void onSignal(int)
+{
+    const char c = 1;
+    ssize_t r = ::write(g_sigFd[1], &c, 1);   // async-signal-safe: 이벤트 루프 쪽에서 quit
+    (void)r;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("QT_Server_headless"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("RemoteBand server without GUI"));
+    parser.addHelpOption();
+    QCommandLineOption portOpt({ QStringLiteral("p"), QStringLiteral("port") },
+                               QStringLiteral("TCP/UDP port (default %1).").arg(PORT),
+                               QStringLiteral("port"), QString::number(PORT));
+    QCommandLineOption audioOpt({ QStringLiteral("a"), QStringLiteral("audio") },
+                                QStringLiteral("Audio sink: device | null | wav:<path>."),
+                                QStringLiteral("sink"));
+    parser.addOption(portOpt);
+    parser.addOption(audioOpt);
+    parser.process(app);
+
+    bool ok = false;
+    const uint port = parser.value(portOpt).toUInt(&ok);
+    if (!ok || port == 0 || port > 65535) {
+        qCritical() << "invalid port" << parser.value(portOpt);
+        return 2;
+    }
+
+    ServerConfig cfg;
+    cfg.port = quint16(port);
+    cfg.audio = parser.value(audioOpt);
+    cfg.recvLog = false;   // 링을 비울 UI 가 없음 (수신 줄은 ServerLog trace 로 볼 수 있다)
+
+    if (::pipe(g_sigFd) != 0) {
+        qCritical() << "pipe failed";
+        return 1;
+    }
+    QSocketNotifier sigNotifier(g_sigFd[0], QSocketNotifier::Read);
+    QObject::connect(&sigNotifier, &QSocketNotifier::activated, &app, [] {
+        char c;
+        ssize_t r = ::read(g_sigFd[0], &c, 1);
+        (void)r;
+        qInfo() << "[SERVER] signal received, stopping";
+        QCoreApplication::quit();
+    });
+    struct sigaction sa = {};
+    sa.sa_handler = onSignal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    ServerLog::start();
+    int rc = 0;
+    {
+        ServerCore core(cfg);
+        QObject::connect(&core, &ServerCore::clientStatsSig, [](const QString &text) {
+            qInfo().noquote() << "[CLIENTS]" << text;
+        });
+        if (core.startServer()) {
+            rc = app.exec();
+        } else {
+            qCritical() << "server start failed on port" << cfg.port;
+            rc = 1;
+        }
+    }
+    ServerLog::stop();   // 코어(네트워크/오디오 스레드)가 정리된 뒤 남은 로그를 비움
+    return rc;
+}
@@ -0,0 +1,116 @@
+#ifndef JITTERBUFFER_H
+#define JITTERBUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+// 재생 지연(playout delay) 설정. GUI 가 원자값으로 쓰고 네트워크 스레드가 이벤트마다 읽는다.
+struct JitterConfig {
+    static const int kMaxDelayMs = 200;
+
+    std::atomic<bool> enabled{false};
+    std::atomic<int>  percentile{95};   // 이 비율의 이벤트가 제때 도착하도록 지연을 고른다
+    std::atomic<int>  maxDelayMs{60};   // 지연 상한. 이보다 늦게 온 이벤트는 late 로 세고 바로 재생
+};
+
+// 클라이언트별 적응형 지터 버퍼 (Qt 비의존, 네트워크 스레드 전용).
+// 이벤트를 실제로 쌓아 두지는 않고 재생 시각만 정한다 (예약 재생은 엔진 블록 클럭이 맡는다).
+//
+//   transit = 수신 시각 - 클라이언트 시각      (두 시계 차이 + 네트워크/캡처 지연)
+//   base    = 최근 kWindow 개 transit 의 최소값 (가장 빨리 온 이벤트를 지연 0 으로 본다)
+//   excess  = transit - base                   (이 이벤트가 늦게 온 정도)
+//   target  = 최근 excess 의 percentile% 값 (상한 maxDelayMs)
+//   delay   : target 이 커지면 바로 올리고, 작아지면 1/8 씩 천천히 내린다
+//   재생    = 클라이언트 시각 + base + delay = 수신 시각 + (delay - excess)
+// 따라서 제때 온 이벤트는 클라이언트가 보낸 간격 그대로 재생된다.
+// excess > delay 인 이벤트는 이미 늦었으므로 수신 즉시 재생하고 late 로 센다.
+// 첫 kRecalcEvery 개 이벤트는 지연을 고르는 중이라 그대로(즉시) 재생하고 late 로 세지 않는다.
+// base 는 창을 따라 움직이므로 두 시계 사이의 느린 drift 도 따라간다.
+class JitterBuffer
+{
+public:
+    static const int kWindow      = 128;   // transit 표본 수
+    static const int kRecalcEvery = 16;    // base/target 재계산 주기 (이벤트 수)
+
+    struct Stats {
+        uint64_t events      = 0;
+        uint64_t late        = 0;   // 지연 안에 못 온 이벤트 (켜져 있을 때만 센다)
+        uint32_t jitterUs    = 0;   // RFC 3550 식 도착 간격 변동 추정
+        uint32_t targetUs    = 0;   // 최근 분포에서 고른 지연
+        uint32_t delayUs     = 0;   // 지금 적용 중인 지연
+        uint32_t maxExcessUs = 0;   // 창 안에서 가장 늦게 온 이벤트
+    };
+
+    // 재생 시각(ns). 꺼져 있으면 추정/통계만 갱신하고 rxNs 를 돌려준다.
+    int64_t playout(int64_t rxNs, uint64_t clientTsUs, const JitterConfig &cfg)
+    {
+        const int64_t transit = rxNs / 1000 - int64_t(clientTsUs);
+
+        if (m_stats.events > 0) {
+            const int64_t d = transit - m_prevTransit;
+            m_jitter16 += (d < 0 ? -d : d) - ((m_jitter16 + 8) >> 4);
+            m_stats.jitterUs = uint32_t(m_jitter16 >> 4);
+        }
+        m_prevTransit = transit;
+
+        m_transit[m_head] = transit;
+        m_head = (m_head + 1) % kWindow;
+        if (m_count < kWindow) ++m_count;
+        if (m_stats.events == 0 || transit < m_base) m_base = transit;   // 더 빨리 온 이벤트 → 즉시 반영
+        ++m_stats.events;
+        if (m_stats.events % kRecalcEvery == 0) recalc(cfg);
+
+        if (!cfg.enabled.load(std::memory_order_relaxed)) return rxNs;
+
+        // 첫 재계산 전에는 delay 가 아직 0 이라 양의 excess 는 전부 late 가 된다 → 세지 않고 바로 재생
+        if (m_stats.events < uint64_t(kRecalcEvery)) return rxNs;
+
+        const int64_t excess = transit - m_base;
+        if (excess > int64_t(m_stats.delayUs)) {
+            ++m_stats.late;
+            return rxNs;
+        }
+        return rxNs + (int64_t(m_stats.delayUs) - excess) * 1000;
+    }
+
+    const Stats &stats() const { return m_stats; }
+
+private:
+    void recalc(const JitterConfig &cfg)
+    {
+        int64_t excess[kWindow];
+        m_base = *std::min_element(m_transit, m_transit + m_count);
+        int64_t maxEx = 0;
+        for (int i = 0; i < m_count; ++i) {
+            excess[i] = m_transit[i] - m_base;
+            if (excess[i] > maxEx) maxEx = excess[i];
+        }
+
+        int pct = cfg.percentile.load(std::memory_order_relaxed);
+        pct = pct < 50 ? 50 : (pct > 100 ? 100 : pct);
+        const int k = (m_count - 1) * pct / 100;
+        std::nth_element(excess, excess + k, excess + m_count);
+
+        const int64_t capUs = int64_t(cfg.maxDelayMs.load(std::memory_order_relaxed)) * 1000;
+        const int64_t target = excess[k] < capUs ? excess[k] : capUs;
+        int64_t delay = m_stats.delayUs;
+        if (delay > capUs) delay = capUs;
+        if (target > delay) delay = target;           // 늘릴 때는 바로
+        else delay -= (delay - target) / 8;           // 줄일 때는 천천히 (한 번 튄 지연에 출렁이지 않게)
+
+        m_stats.targetUs    = uint32_t(target);
+        m_stats.delayUs     = uint32_t(delay);
+        m_stats.maxExcessUs = uint32_t(maxEx);
+    }
+
+    int64_t m_transit[kWindow] = {};
+    int     m_head  = 0;
+    int     m_count = 0;
+    int64_t m_base  = 0;
+    int64_t m_prevTransit = 0;
+    int64_t m_jitter16    = 0;   // jitter * 16 (정수 EWMA)
+    Stats   m_stats;
+};
+
+#endif // JITTERBUFFER_H
@@ -0,0 +1,101 @@
+#ifndef JOURNALFORMAT_H
+#define JOURNALFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// 이벤트 저널 파일 포맷 (Qt 비의존, header-only).
+// 서버(EventJournal)가 수락한 노트 이벤트를 세그먼트 파일에 고정 크기 레코드로 덧붙이고,
+// tools/replay(서버로 다시 재생)와 tools/render(WAV 로 렌더)가 같은 뷰로 읽는다.
+//
+//   [JournalHeader 64B][JournalRecord 40B x capacity]
+//   파일은 capacity 만큼 미리 잡아 두고, header.count 까지만 유효하다 (쓰기 도중 죽어도 그 앞까지는 온전).
+//   세그먼트가 차면 <prefix>-001.bandj, -002 ... 로 넘어간다. 정상 종료 시 사용한 길이로 잘라낸다.
+
+static const char     kJournalMagic[8]  = { 'B','A','N','D','J','R','N','1' };
+static const uint32_t kJournalVersion   = 1;
+static const int      kJournalIdLen     = 16;
+
+enum JournalTransport : uint8_t {
+    JOURNAL_TEXT = 0,   // "[DRUM]3" 텍스트 줄 (seq = 연결별 노트 번호, clientTsUs = 0)
+    JOURNAL_BIN  = 1,   // TCP 바이너리 레코드
+    JOURNAL_UDP  = 2,   // UDP 데이터그램
+};
+
+#pragma pack(push, 1)
+struct JournalHeader {
+    char     magic[8];          // kJournalMagic
+    uint32_t version;           // kJournalVersion
+    uint32_t recordSize;        // sizeof(JournalRecord)
+    uint64_t capacity;          // 이 세그먼트에 들어갈 수 있는 레코드 수
+    uint64_t count;             // 기록 완료된 레코드 수 (레코드를 쓴 뒤에 올린다)
+    int64_t  startMonoNs;       // 세그먼트를 연 시각 (서버 단조 시계, rxNs 와 같은 축)
+    int64_t  startWallMs;       // 같은 순간의 벽시계 (Unix epoch ms, 사람이 볼 때만)
+    uint32_t segment;           // 0, 1, 2 ...
+    uint8_t  reserved[12];
+};
+
+struct JournalRecord {
+    int64_t  rxNs;                  // 서버 수신 시각 (단조 시계)
+    uint64_t clientTsUs;            // BIN/UDP 레코드의 클라이언트 시각, 텍스트는 0
+    uint32_t seq;                   // BIN/UDP: 클라이언트 seq, 텍스트: 연결별 노트 번호
+    uint8_t  instrument;            // BandInstrument
+    uint8_t  note;
+    uint8_t  velocity;              // 0 = 속도 정보 없음
+    uint8_t  transport;             // JournalTransport
+    char     clientId[kJournalIdLen];   // 로그인 ID, NUL 패딩 (길면 잘림)
+};
+#pragma pack(pop)
+
+static_assert(sizeof(JournalHeader) == 64, "JournalHeader must be 64 bytes");
+static_assert(sizeof(JournalRecord) == 40, "JournalRecord must be 40 bytes");
+
+// mmap 된(또는 통째로 읽은) 세그먼트 읽기 뷰. base 가 살아 있는 동안만 유효.
+// 쓰는 중인 세그먼트도 열 수 있다 (그 순간의 count 까지만 보인다).
+class JournalView
+{
+public:
+    bool open(const void *base, size_t size, std::string *err = nullptr)
+    {
+        m_hdr = nullptr;
+        m_count = 0;
+        const JournalHeader *h = static_cast<const JournalHeader*>(base);
+        if (!base || size < sizeof(JournalHeader)) return fail(err, "journal too small");
+        if (std::memcmp(h->magic, kJournalMagic, sizeof(h->magic)) != 0) return fail(err, "bad magic");
+        if (h->version != kJournalVersion) return fail(err, "unsupported version");
+        if (h->recordSize != sizeof(JournalRecord)) return fail(err, "record size mismatch");
+
+        const uint64_t count = __atomic_load_n(&h->count, __ATOMIC_ACQUIRE);
+        const uint64_t fits  = (size - sizeof(JournalHeader)) / sizeof(JournalRecord);
+        if (count > h->capacity) return fail(err, "count beyond capacity");
+        m_count = count < fits ? count : fits;   // 잘린 파일이면 온전한 레코드까지만
+        m_hdr = h;
+        return true;
+    }
+
+    bool     isOpen() const { return m_hdr != nullptr; }
+    const JournalHeader &header() const { return *m_hdr; }
+    uint64_t count() const { return m_count; }
+    const JournalRecord &record(uint64_t i) const {
+        return reinterpret_cast<const JournalRecord*>(m_hdr + 1)[i];
+    }
+
+private:
+    static bool fail(std::string *err, const char *msg) {
+        if (err) *err = msg;
+        return false;
+    }
+
+    const JournalHeader *m_hdr = nullptr;
+    uint64_t             m_count = 0;
+};
+
+// clientId 필드 → 문자열 (NUL 이 없을 수도 있음)
+static inline std::string journalClientId(const JournalRecord &r)
+{
+    return std::string(r.clientId, strnlen(r.clientId, sizeof(r.clientId)));
+}
+
+#endif // JOURNALFORMAT_H
@@ -0,0 +1,95 @@
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <cstdint>
+#include <cstring>
+
+// 이벤트별 서버 내부 지연 측정 (Qt 비의존).
+//
+//   rx ──parse──▶ 파싱 완료 ──queue──▶ 엔진 큐 투입 ──wait──▶ 오디오 버퍼에 첫 샘플 ──device──▶ 출력(추정)
+//   rx    : readyRead(또는 UDP datagram) 묶음을 읽은 시각
+//   wait  : 큐 대기 + 다음 pull 콜백까지 (오디오 백엔드 주기), 퀀타이즈 켜짐이면 예약 지연 포함
+//   device: 그 시점에 출력 버퍼에 이미 쌓여 있던 분량 (QAudioOutput bufferSize - bytesFree)
+
+enum LatencyStage {
+    LAT_PARSE = 0,   // rx → parse
+    LAT_QUEUE,       // parse → queue
+    LAT_WAIT,        // queue → render
+    LAT_TOTAL,       // rx → render (서버 안에서의 총 지연)
+    LAT_DEVICE,      // render → 스피커 (추정)
+    LAT_STAGE_COUNT
+};
+
+static const char *const kLatencyStageNames[LAT_STAGE_COUNT] = {
+    "recv→parse", "parse→queue", "queue→render", "recv→render", "render→out(est)"
+};
+
+// 오디오 스레드 → UI 로 넘기는 이벤트 1건 (us)
+struct LatencySample {
+    uint32_t us[LAT_STAGE_COUNT] = {};
+    uint8_t  instrument = 0;
+};
+
+// 로그-선형 버킷 히스토그램 (HDR 히스토그램 축소판, 상대오차 ~6%).
+// 0~15us 는 1us 단위, 그 위로는 2의 거듭제곱 구간마다 16칸.
+class LatencyHistogram
+{
+public:
+    static const int kSub     = 16;
+    static const int kBuckets = kSub + (32 - 4) * kSub;
+
+    void record(uint32_t us) {
+        ++m_counts[bucketOf(us)];
+        ++m_total;
+        if (us > m_max) m_max = us;
+    }
+    void reset() {
+        std::memset(m_counts, 0, sizeof(m_counts));
+        m_total = 0;
+        m_max = 0;
+    }
+
+    uint64_t count() const { return m_total; }
+    uint32_t max() const   { return m_max; }
+
+    // p: 0~100. 해당 버킷의 상한값(최대값으로 제한)을 돌려준다
+    uint32_t percentile(double p) const {
+        if (m_total == 0) return 0;
+        uint64_t rank = uint64_t(p / 100.0 * double(m_total) + 0.5);
+        if (rank < 1) rank = 1;
+        uint64_t acc = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            acc += m_counts[i];
+            if (acc >= rank) {
+                const uint64_t hi = uint64_t(bucketLow(i)) + bucketWidth(i) - 1;
+                return hi < m_max ? uint32_t(hi) : m_max;
+            }
+        }
+        return m_max;
+    }
+
+    uint64_t bucketCount(int i) const { return m_counts[i]; }
+
+    static int bucketOf(uint32_t v) {
+        if (v < uint32_t(kSub)) return int(v);
+        const int e = 31 - __builtin_clz(v);          // v 의 최상위 비트 (>= 4)
+        const int sub = int(v >> (e - 4)) & (kSub - 1);
+        return kSub + (e - 4) * kSub + sub;
+    }
+    static uint32_t bucketLow(int i) {
+        if (i < kSub) return uint32_t(i);
+        const int e = (i - kSub) / kSub + 4;
+        const int sub = (i - kSub) % kSub;
+        return uint32_t(kSub + sub) << (e - 4);
+    }
+    static uint32_t bucketWidth(int i) {
+        return i < kSub ? 1u : (1u << ((i - kSub) / kSub));
+    }
+
+private:
+    uint64_t m_counts[kBuckets] = {};
+    uint64_t m_total = 0;
+    uint32_t m_max = 0;
+};
+
+#endif // LATENCYSTATS_H
@@ -0,0 +1,146 @@
+#include "latencywidget.h"
+#include "audioengine.h"
+
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTextStream>
+#include <QVBoxLayout>
+#include <QDebug>
+
+static const char *const kInstrumentNames[BAND_INST_COUNT] = { "Guita", "Drum", "Piano" };
+
+enum { COL_INST, COL_STAGE, COL_COUNT, COL_P50, COL_P95, COL_P99, COL_MAX, COL_NUM };
+
+LatencyWidget::LatencyWidget(AudioEngine *engine, QWidget *parent)
+    : QWidget(parent)
+    , m_engine(engine)
+{
+    auto *v = new QVBoxLayout(this);
+
+    auto *top = new QHBoxLayout;
+    m_summary = new QLabel(this);
+    auto *reset = new QPushButton(tr("Reset"), this);
+    auto *save  = new QPushButton(tr("Save CSV..."), this);
+    top->addWidget(m_summary, 1);
+    top->addWidget(reset);
+    top->addWidget(save);
+    v->addLayout(top);
+
+    m_table = new QTableWidget(BAND_INST_COUNT * LAT_STAGE_COUNT, COL_NUM, this);
+    m_table->setHorizontalHeaderLabels({ tr("Instrument"), tr("Stage"), tr("Count"),
+                                         tr("p50 (us)"), tr("p95 (us)"), tr("p99 (us)"), tr("max (us)") });
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    for (int i = 0; i < BAND_INST_COUNT; ++i) {
+        for (int s = 0; s < LAT_STAGE_COUNT; ++s) {
+            const int row = i * LAT_STAGE_COUNT + s;
+            m_table->setItem(row, COL_INST,  new QTableWidgetItem(s == 0 ? QString::fromLatin1(kInstrumentNames[i]) : QString()));
+            m_table->setItem(row, COL_STAGE, new QTableWidgetItem(QString::fromUtf8(kLatencyStageNames[s])));
+            for (int c = COL_COUNT; c < COL_NUM; ++c) {
+                auto *item = new QTableWidgetItem;
+                item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                m_table->setItem(row, c, item);
+            }
+        }
+    }
+    v->addWidget(m_table, 1);
+
+    connect(reset, &QPushButton::clicked, this, &LatencyWidget::resetStats);
+    connect(save,  &QPushButton::clicked, this, &LatencyWidget::onSaveClicked);
+    connect(&m_timer, &QTimer::timeout, this, &LatencyWidget::poll);
+    m_timer.start(kPollMs);
+    refreshTable();
+}
+
+void LatencyWidget::poll()
+{
+    // 링은 탭이 안 보여도 비워야 엔진 쪽에서 넘치지 않는다
+    LatencySample s;
+    while (m_engine && m_engine->popLatency(s)) {
+        if (s.instrument >= BAND_INST_COUNT) continue;
+        for (int k = 0; k < LAT_STAGE_COUNT; ++k)
+            m_hist[s.instrument][k].record(s.us[k]);
+        ++m_events;
+        m_dirty = true;
+    }
+    if (m_dirty && isVisible()) refreshTable();
+}
+
+void LatencyWidget::refreshTable()
+{
+    for (int i = 0; i < BAND_INST_COUNT; ++i) {
+        for (int s = 0; s < LAT_STAGE_COUNT; ++s) {
+            const LatencyHistogram &h = m_hist[i][s];
+            const int row = i * LAT_STAGE_COUNT + s;
+            const bool any = h.count() > 0;
+            m_table->item(row, COL_COUNT)->setText(QString::number(h.count()));
+            m_table->item(row, COL_P50)->setText(any ? QString::number(h.percentile(50)) : QString());
+            m_table->item(row, COL_P95)->setText(any ? QString::number(h.percentile(95)) : QString());
+            m_table->item(row, COL_P99)->setText(any ? QString::number(h.percentile(99)) : QString());
+            m_table->item(row, COL_MAX)->setText(any ? QString::number(h.max()) : QString());
+        }
+    }
+    m_summary->setText(tr("events %1   dropped %2")
+                       .arg(m_events).arg(m_engine ? m_engine->latencyDropped() : 0));
+    m_dirty = false;
+}
+
+void LatencyWidget::resetStats()
+{
+    for (auto &inst : m_hist)
+        for (LatencyHistogram &h : inst) h.reset();
+    m_events = 0;
+    refreshTable();
+}
+
+void LatencyWidget::onSaveClicked()
+{
+    const QString path = QFileDialog::getSaveFileName(this, tr("Save latency CSV"),
+                                                      QStringLiteral("latency.csv"), tr("CSV (*.csv)"));
+    if (!path.isEmpty()) saveCsv(path);
+}
+
+// path            : 악기 × 구간 요약 (count, p50/p95/p99/max)
+// <path>_buckets  : 비어 있지 않은 히스토그램 버킷 (lo_us, hi_us, count)
+bool LatencyWidget::saveCsv(const QString &path)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qWarning() << "[LATENCY] csv open fail:" << path;
+        return false;
+    }
+    QTextStream ts(&f);
+    ts << "instrument,stage,count,p50_us,p95_us,p99_us,max_us\n";
+    for (int i = 0; i < BAND_INST_COUNT; ++i)
+        for (int s = 0; s < LAT_STAGE_COUNT; ++s) {
+            const LatencyHistogram &h = m_hist[i][s];
+            ts << kInstrumentNames[i] << ',' << QString::fromUtf8(kLatencyStageNames[s]) << ','
+               << h.count() << ',' << h.percentile(50) << ',' << h.percentile(95) << ','
+               << h.percentile(99) << ',' << h.max() << '\n';
+        }
+
+    const QFileInfo fi(path);
+    QFile fb(fi.path() + QLatin1Char('/') + fi.completeBaseName() + QStringLiteral("_buckets.csv"));
+    if (fb.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        QTextStream tb(&fb);
+        tb << "instrument,stage,lo_us,hi_us,count\n";
+        for (int i = 0; i < BAND_INST_COUNT; ++i)
+            for (int s = 0; s < LAT_STAGE_COUNT; ++s)
+                for (int b = 0; b < LatencyHistogram::kBuckets; ++b) {
+                    const quint64 n = m_hist[i][s].bucketCount(b);
+                    if (!n) continue;
+                    const quint32 lo = LatencyHistogram::bucketLow(b);
+                    tb << kInstrumentNames[i] << ',' << QString::fromUtf8(kLatencyStageNames[s]) << ','
+                       << lo << ',' << (lo + LatencyHistogram::bucketWidth(b) - 1) << ',' << n << '\n';
+                }
+    }
+    qInfo() << "[LATENCY] saved" << path << "events" << m_events;
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef LATENCYWIDGET_H
+#define LATENCYWIDGET_H
+
+#include <QWidget>
+#include <QTimer>
+
+#include "band_protocol.h"
+#include "latencystats.h"
+
+class AudioEngine;
+class QTableWidget;
+class QLabel;
+
+// 지연 탭: 엔진이 넘겨 준 이벤트별 측정값을 악기 × 구간 히스토그램으로 모아
+// p50/p95/p99/max 를 보여 주고 CSV 로 저장한다.
+// 측정값은 타이머로 엔진 링에서 꺼낸다 (이 위젯이 유일한 소비자).
+class LatencyWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    static const int kPollMs = 250;
+
+    explicit LatencyWidget(AudioEngine *engine, QWidget *parent = nullptr);
+
+public slots:
+    void resetStats();
+    bool saveCsv(const QString &path);
+
+private slots:
+    void poll();
+    void onSaveClicked();
+
+private:
+    void refreshTable();
+
+    AudioEngine      *m_engine = nullptr;
+    QTimer            m_timer;
+    QTableWidget     *m_table = nullptr;
+    QLabel           *m_summary = nullptr;
+    LatencyHistogram  m_hist[BAND_INST_COUNT][LAT_STAGE_COUNT];
+    quint64           m_events = 0;
+    bool              m_dirty = true;
+};
+
+#endif // LATENCYWIDGET_H
@@ -1,11 +1,18 @@
 #include "mainwidget.h"
+#include "serverlog.h"
 
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
-    MainWidget w;
-    w.show();
-    return a.exec();
+    ServerLog::start();
+    int rc;
+    {
+        MainWidget w;
+        w.show();
+        rc = a.exec();
+    }
+    ServerLog::stop();   // 위젯(네트워크 스레드 포함)이 모두 정리된 뒤 남은 로그를 비움
+    return rc;
 }
@@ -8,23 +8,33 @@ MainWidget::MainWidget(QWidget *parent)
 {
     ui->setupUi(this);
 
-    // Tab1: 서버 위젯
+    // Tab1: 서버 (ServerCore 를 들고 있는 로그/상태 뷰)
     pTab1SocketServer = new Tab1Socketserver(this);
     if (!ui->pTab1->layout()) ui->pTab1->setLayout(new QVBoxLayout);
     ui->pTab1->layout()->addWidget(pTab1SocketServer);
 
+    // 지연 탭: Tab1 바로 옆
+    m_latency = new LatencyWidget(pTab1SocketServer->serverCore()->engine(), this);
+    ui->tabWidget->insertTab(1, m_latency, tr("Latency"));
+
+    // 템포/퀀타이즈 탭
+    m_tempo = new TempoWidget(pTab1SocketServer->serverCore()->tempo(), this);
+    ui->tabWidget->insertTab(2, m_tempo, tr("Tempo"));
+    connect(m_tempo, &TempoWidget::settingsChanged,
+            pTab1SocketServer->serverCore(), &ServerCore::saveTempoSettings);
+
     // Tab2: 믹서 위젯 ★
-    m_mixer = new MixerWidget(this);
+    m_mixer = new MixerWidget(pTab1SocketServer->serverCore()->engine(), this);
     if (!ui->pTab2->layout()) ui->pTab2->setLayout(new QVBoxLayout);
     ui->pTab2->layout()->addWidget(m_mixer);
 
     // 믹서 → 서버 연결 ★
-    if (pTab1SocketServer && pTab1SocketServer->serverWidget()) {
-        auto *srv = pTab1SocketServer->serverWidget();
-        connect(m_mixer, SIGNAL(mixerVolume(QString,int)),
-                srv,     SLOT(onMixerVolume(QString,int)));
-        connect(m_mixer, SIGNAL(mixerMute(QString,bool)),
-                srv,     SLOT(onMixerMute(QString,bool)));
+    if (pTab1SocketServer && pTab1SocketServer->serverCore()) {
+        auto *srv = pTab1SocketServer->serverCore();
+        connect(m_mixer, SIGNAL(mixerVolume(int,int)),
+                srv,     SLOT(onMixerVolume(int,int)));
+        connect(m_mixer, SIGNAL(mixerMute(int,bool)),
+                srv,     SLOT(onMixerMute(int,bool)));
     }
 }
 
@@ -12,6 +12,8 @@
 
 #include "tab1socketserver.h"
 #include "mixerwidget.h"
+#include "latencywidget.h"
+#include "tempowidget.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWidget; }
@@ -29,5 +31,7 @@ private:
     Ui::MainWidget *ui;
     Tab1Socketserver *pTab1SocketServer;
     MixerWidget *m_mixer = nullptr;
+    LatencyWidget *m_latency = nullptr;
+    TempoWidget *m_tempo = nullptr;
 };
 #endif // MAINWIDGET_H
@@ -0,0 +1,266 @@
+#include "mixercore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+MixerCore::MixerCore(int sampleRate)
+    : m_sampleRate(sampleRate)
+    , m_rampFrames(std::max(1, sampleRate * kGainRampMs / 1000))
+{
+    std::memset(m_busMix, 0, sizeof(m_busMix));
+    std::memset(m_mix, 0, sizeof(m_mix));
+}
+
+bool MixerCore::setSample(int id, std::vector<int16_t> pcm)
+{
+    if (id < 0 || id >= kMaxSamples) return false;
+    Sample &s = m_samples[id];
+    s.frames = int(pcm.size() / 2);
+    s.owned  = std::move(pcm);
+    s.pcm    = s.owned.data();
+    return true;
+}
+
+bool MixerCore::setSampleView(int id, const int16_t *pcm, int frames)
+{
+    if (id < 0 || id >= kMaxSamples || (!pcm && frames > 0)) return false;
+    Sample &s = m_samples[id];
+    std::vector<int16_t>().swap(s.owned);
+    s.pcm    = pcm;
+    s.frames = frames;
+    return true;
+}
+
+void MixerCore::shareSamples(const MixerCore &src)
+{
+    for (int i = 0; i < kMaxSamples; ++i)
+        setSampleView(i, src.m_samples[i].pcm, src.m_samples[i].frames);
+}
+
+bool MixerCore::hasSample(int id) const
+{
+    return id >= 0 && id < kMaxSamples && m_samples[id].frames > 0;
+}
+
+int MixerCore::sampleFrames(int id) const
+{
+    return hasSample(id) ? m_samples[id].frames : 0;
+}
+
+int MixerCore::activeVoices() const
+{
+    int n = 0;
+    for (const Voice &v : m_voices) if (v.sample >= 0) ++n;
+    return n;
+}
+
+// 보이스 선택 규칙 (스틸링은 트리거당 최대 1개로 한정)
+//  1) 같은 샘플이 kMaxVoicesPerSample 개 이상 울리고 있으면 그 중 가장 오래된 것 재사용
+//  2) 빈 보이스
+//  3) 전체에서 가장 오래된 보이스
+int MixerCore::pickVoice(int sampleId)
+{
+    int sameCount = 0, sameOldest = -1, freeIdx = -1, oldest = 0;
+    for (int i = 0; i < kMaxVoices; ++i) {
+        const Voice &v = m_voices[i];
+        if (v.sample < 0) { if (freeIdx < 0) freeIdx = i; continue; }
+        if (v.sample == sampleId) {
+            ++sameCount;
+            if (sameOldest < 0 || int32_t(v.serial - m_voices[sameOldest].serial) < 0) sameOldest = i;
+        }
+        if (m_voices[oldest].sample < 0 || int32_t(v.serial - m_voices[oldest].serial) < 0) oldest = i;
+    }
+    if (sameCount >= kMaxVoicesPerSample) { ++m_stolen; return sameOldest; }
+    if (freeIdx >= 0) return freeIdx;
+    ++m_stolen;
+    return oldest;
+}
+
+int MixerCore::trigger(int sampleId, float gain, int channel, int delayFrames)
+{
+    if (!hasSample(sampleId)) return -1;
+    const int idx = pickVoice(sampleId);
+    Voice &v = m_voices[idx];
+    v.sample  = sampleId;
+    v.pos     = 0;
+    v.gain    = gain;
+    v.serial  = ++m_serial;
+    v.channel = (channel >= 0 && channel < kMaxChannels) ? channel : 0;
+    v.delay   = std::max(0, delayFrames);
+    return idx;
+}
+
+void MixerCore::setChannel(int channel, float gain, float pan)
+{
+    if (channel < 0 || channel >= kMaxChannels) return;
+    gain = std::max(0.f, gain);
+    pan  = std::max(-1.f, std::min(1.f, pan));
+    // 밸런스 법칙: 가운데 = 좌우 모두 1.0 (기존 음량 유지), 한쪽으로 갈수록 반대쪽만 줄어든다
+    const float tl = gain * (pan > 0.f ? 1.f - pan : 1.f);
+    const float tr = gain * (pan < 0.f ? 1.f + pan : 1.f);
+    Bus &b = m_buses[channel];
+    if (tl == b.tl && tr == b.tr) return;
+    b.tl = tl;
+    b.tr = tr;
+    b.dl = (tl - b.gl) / float(m_rampFrames);
+    b.dr = (tr - b.gr) / float(m_rampFrames);
+    b.rampLeft = m_rampFrames;
+}
+
+float MixerCore::channelGain(int channel) const
+{
+    if (channel < 0 || channel >= kMaxChannels) return 0.f;
+    return 0.5f * (m_buses[channel].gl + m_buses[channel].gr);
+}
+
+void MixerCore::render(int16_t *out, int frames)
+{
+    while (frames > 0) {
+        const int n = std::min(frames, int(kBlockFrames));
+        mixBlock(out, n);
+        out    += n * 2;
+        frames -= n;
+        m_framesRendered += uint64_t(n);
+    }
+}
+
+// 스테레오 interleaved 버퍼의 좌/우 |x| 최대와 제곱합.
+// 독립 누적 4레인(L R L R) → 재결합(-ffast-math) 없이도 컴파일러가 SIMD 한 레지스터로 묶는다.
+static void meterReduce(const float *x, int frames, float peak[2], float sumSq[2])
+{
+    float pk[4] = { 0.f, 0.f, 0.f, 0.f };
+    float sq[4] = { 0.f, 0.f, 0.f, 0.f };
+    const int n = frames * 2;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int k = 0; k < 4; ++k) {
+            const float a = x[i + k];
+            const float m = a < 0.f ? -a : a;
+            pk[k] = pk[k] > m ? pk[k] : m;
+            sq[k] += a * a;
+        }
+    }
+    for (; i < n; i += 2) {   // 홀수 프레임 꼬리
+        for (int k = 0; k < 2; ++k) {
+            const float a = x[i + k];
+            pk[k] = std::max(pk[k], std::fabs(a));
+            sq[k] += a * a;
+        }
+    }
+    peak[0]  = std::max(pk[0], pk[2]);
+    peak[1]  = std::max(pk[1], pk[3]);
+    sumSq[0] = sq[0] + sq[2];
+    sumSq[1] = sq[1] + sq[3];
+}
+
+// 버스 → 마스터. 보간 구간만 프레임 단위로 게인을 움직이고 나머지는 고정 게인 루프.
+// 미터는 게인 적용 후 값: 고정 구간은 원본 버스를 한 번 훑고 게인(제곱)을 곱한다.
+void MixerCore::mixBus(Bus &b, Meter &m, const float *src, float *dst, int frames)
+{
+    int i = 0;
+    for (; i < frames && b.rampLeft > 0; ++i) {
+        b.gl += b.dl;
+        b.gr += b.dr;
+        if (--b.rampLeft == 0) { b.gl = b.tl; b.gr = b.tr; }
+        const float l = src[2 * i] * b.gl, r = src[2 * i + 1] * b.gr;
+        dst[2 * i]     += l;
+        dst[2 * i + 1] += r;
+        m.peak   = std::max(m.peak, std::max(std::fabs(l), std::fabs(r)));
+        m.sumSq += double(l) * l + double(r) * r;
+    }
+    if (i == frames) return;
+    const float gl = b.gl, gr = b.gr;
+    if (gl == 0.f && gr == 0.f) return;
+    for (int j = i; j < frames; ++j) {
+        dst[2 * j]     += src[2 * j]     * gl;
+        dst[2 * j + 1] += src[2 * j + 1] * gr;
+    }
+    float pk[2], sq[2];
+    meterReduce(src + 2 * i, frames - i, pk, sq);
+    m.peak   = std::max(m.peak, std::max(pk[0] * gl, pk[1] * gr));
+    m.sumSq += double(sq[0]) * gl * gl + double(sq[1]) * gr * gr;
+}
+
+void MixerCore::takeLevels(Levels &out)
+{
+    const float fs = 32768.f;
+    const double n = double(m_meterFrames) * 2;
+    for (int ch = 0; ch <= kMaxChannels; ++ch) {
+        Meter &m = m_meters[ch];
+        out.peak[ch] = m.peak / fs;
+        out.rms[ch]  = n > 0 ? float(std::sqrt(m.sumSq / n)) / fs : 0.f;
+        m = Meter();
+    }
+    out.clipped = m_clipped;
+    out.frames  = m_meterFrames;
+    m_clipped = 0;
+    m_meterFrames = 0;
+}
+
+void MixerCore::mixBlock(int16_t *out, int frames)
+{
+    float *mix = m_mix;
+    std::fill(mix, mix + frames * 2, 0.f);
+
+    for (Bus &b : m_buses) b.active = false;
+
+    for (Voice &v : m_voices) {
+        if (v.sample < 0) continue;
+        if (v.delay >= frames) { v.delay -= frames; continue; }   // 아직 시작 전
+        const int off = v.delay;
+        v.delay = 0;
+        Bus &b = m_buses[v.channel];
+        float *bus = m_busMix[v.channel];
+        if (!b.active) {
+            std::fill(bus, bus + frames * 2, 0.f);
+            b.active = true;
+        }
+        const Sample &s = m_samples[v.sample];
+        const int n = std::min(frames - off, s.frames - v.pos);
+        const int16_t *src = s.pcm + size_t(v.pos) * 2;
+        float *dst = bus + off * 2;
+        const float g = v.gain;
+        for (int i = 0; i < n * 2; ++i)
+            dst[i] += float(src[i]) * g;
+        v.pos += n;
+        if (v.pos >= s.frames) v.sample = -1;
+    }
+
+    for (int ch = 0; ch < kMaxChannels; ++ch) {
+        Bus &b = m_buses[ch];
+        if (b.active) {
+            mixBus(b, m_meters[ch], m_busMix[ch], mix, frames);
+        } else if (b.rampLeft > 0) {
+            // 소리는 없어도 보간은 시간대로 진행시킨다
+            const int n = std::min(frames, b.rampLeft);
+            b.gl += b.dl * float(n);
+            b.gr += b.dr * float(n);
+            b.rampLeft -= n;
+            if (b.rampLeft == 0) { b.gl = b.tl; b.gr = b.tr; }
+        }
+    }
+
+    // 마스터 미터는 클리핑 전 값 (잘린 만큼 peak 가 1.0 을 넘는다)
+    float pk[2], sq[2];
+    meterReduce(mix, frames, pk, sq);
+    const float blockPeak = std::max(pk[0], pk[1]);
+    Meter &mm = m_meters[kMasterMeter];
+    mm.peak   = std::max(mm.peak, blockPeak);
+    mm.sumSq += double(sq[0]) + double(sq[1]);
+    m_meterFrames += uint32_t(frames);
+
+    if (blockPeak <= 32767.f) {   // 대부분의 블록: 범위 검사 없이 변환
+        for (int i = 0; i < frames * 2; ++i)
+            out[i] = int16_t(mix[i]);
+        return;
+    }
+    uint32_t clipped = 0;
+    for (int i = 0; i < frames * 2; ++i) {
+        const float x = mix[i];
+        const float c = std::max(-32768.f, std::min(32767.f, x));
+        clipped += (c != x);
+        out[i] = int16_t(c);
+    }
+    m_clipped += clipped;
+}
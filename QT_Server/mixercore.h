@@ -0,0 +1,113 @@
+#ifndef MIXERCORE_H
+#define MIXERCORE_H
+
+#include <cstdint>
+#include <vector>
+
+// 오디오 엔진의 믹싱 코어 (Qt 비의존).
+// - 샘플은 미리 디코딩된 스테레오 interleaved int16 PCM 으로 보관
+// - 고정 크기 보이스 풀에서 할당 → 같은 노트 연타도 겹쳐서 재생됨
+// - render() 는 오디오 출력 콜백(pull)에서 호출된다. 내부에서 메모리 할당 없음.
+// - 보이스는 채널 버스(악기별)에 먼저 더해지고, 버스마다 게인/팬을 곱해 마스터로 합친다.
+//   채널 게인 변경은 kGainRampMs 동안 샘플 단위로 선형 보간 (슬라이더 지퍼 노이즈 없음).
+// - 버스(게인 적용 후)와 마스터(클리핑 전)의 peak/제곱합을 믹스하면서 누적 → takeLevels() 로 꺼낸다.
+class MixerCore
+{
+public:
+    static const int kMaxVoices         = 32;  // 전체 동시 발음 수
+    static const int kMaxVoicesPerSample = 6;  // 같은 샘플 연타 시 최대 겹침 수
+    static const int kMaxSamples        = 32;
+    static const int kBlockFrames       = 512; // 내부 믹스 버퍼 크기(프레임)
+    static const int kMaxChannels       = 4;   // 채널 버스 수
+    static const int kGainRampMs        = 10;  // 채널 게인/팬 보간 길이
+    static const int kMasterMeter       = kMaxChannels;   // Levels 배열에서 마스터 자리
+
+    // 레벨 미터 (full scale = 1.0). 마지막 takeLevels() 이후 구간의 값.
+    struct Levels {
+        float    peak[kMaxChannels + 1] = {};   // 절댓값 최대. 1.0 이상이면 그 버스/마스터가 full scale 을 넘었다
+        float    rms[kMaxChannels + 1]  = {};
+        uint32_t clipped = 0;                   // 마스터에서 int16 로 잘린 샘플 수
+        uint32_t frames  = 0;                   // 구간 길이
+    };
+
+    explicit MixerCore(int sampleRate = 48000);
+    // Sample::pcm 이 owned 를 가리키므로 복사하면 원본을 참조하게 된다 → 복사 금지, shareSamples() 를 쓸 것
+    MixerCore(const MixerCore &) = delete;
+    MixerCore &operator=(const MixerCore &) = delete;
+
+    int sampleRate() const { return m_sampleRate; }
+
+    // 엔진 시작 전에 채워 둔다 (render 와 동시 호출 금지)
+    bool setSample(int id, std::vector<int16_t> pcm);
+    // 외부 메모리(mmap 된 샘플 뱅크 등)를 복사 없이 참조. 코어보다 오래 살아 있어야 한다.
+    bool setSampleView(int id, const int16_t *pcm, int frames);
+    // src 의 샘플을 복사 없이 참조 (setSampleView 와 같은 규칙: src 가 이 코어보다 오래 살아 있어야 한다)
+    void shareSamples(const MixerCore &src);
+    bool hasSample(int id) const;
+    int  sampleFrames(int id) const;
+
+    // 보이스 1개 할당. 반환값: 보이스 인덱스 (-1 = 샘플 없음)
+    // delayFrames > 0 이면 다음 render 시작부터 그만큼 뒤 프레임에서 울리기 시작한다 (블록을 넘어가도 됨)
+    int trigger(int sampleId, float gain, int channel = 0, int delayFrames = 0);
+
+    // 채널 목표 게인(0.0~) / 팬(-1.0 왼쪽 ~ +1.0 오른쪽). render 와 같은 스레드에서 호출.
+    // 값이 바뀌면 다음 render 부터 kGainRampMs 에 걸쳐 목표값으로 이동한다.
+    void setChannel(int channel, float gain, float pan);
+    float channelGain(int channel) const;   // 현재(보간 중) 값, 좌우 평균
+
+    // 스테레오 int16 frames 개를 out 에 채운다
+    void render(int16_t *out, int frames);
+
+    // 누적된 미터 값을 내보내고 0 으로 되돌린다. render 와 같은 스레드에서 호출.
+    void takeLevels(Levels &out);
+
+    int      activeVoices() const;
+    uint64_t stolenVoices() const { return m_stolen; }
+    uint64_t framesRendered() const { return m_framesRendered; }
+
+private:
+    struct Sample {
+        std::vector<int16_t> owned;     // setSample() 로 넘겨받은 경우만
+        const int16_t *pcm = nullptr;   // owned 또는 외부 메모리
+        int frames = 0;
+    };
+    struct Voice {
+        int      sample = -1;   // -1 = 비어 있음
+        int      pos    = 0;    // 재생 위치(프레임)
+        float    gain   = 0.f;
+        uint32_t serial = 0;    // 할당 순서 (스틸링 시 가장 오래된 보이스 선택)
+        int      channel = 0;
+        int      delay  = 0;    // 시작까지 남은 프레임 (예약 재생)
+    };
+    struct Bus {
+        float gl = 1.f, gr = 1.f;    // 현재 좌/우 게인
+        float tl = 1.f, tr = 1.f;    // 목표
+        float dl = 0.f, dr = 0.f;    // 프레임당 증가량
+        int   rampLeft = 0;          // 남은 보간 프레임
+        bool  active = false;        // 이번 블록에 보이스가 더해졌는지
+    };
+    struct Meter {
+        float  peak  = 0.f;          // int16 스케일
+        double sumSq = 0.0;
+    };
+
+    int  pickVoice(int sampleId);
+    void mixBlock(int16_t *out, int frames);
+    static void mixBus(Bus &b, Meter &m, const float *src, float *dst, int frames);
+
+    int      m_sampleRate;
+    Sample   m_samples[kMaxSamples];
+    Voice    m_voices[kMaxVoices];
+    int      m_rampFrames;
+    Bus      m_buses[kMaxChannels];
+    float    m_busMix[kMaxChannels][kBlockFrames * 2];
+    float    m_mix[kBlockFrames * 2];
+    Meter    m_meters[kMaxChannels + 1];
+    uint32_t m_meterFrames = 0;
+    uint32_t m_clipped = 0;
+    uint32_t m_serial = 0;
+    uint64_t m_stolen = 0;
+    uint64_t m_framesRendered = 0;
+};
+
+#endif // MIXERCORE_H
@@ -1,14 +1,83 @@
 #include "mixerwidget.h"
+#include "audioengine.h"
+#include <QDateTime>
 #include <QHBoxLayout>
+#include <QPainter>
 #include <QVBoxLayout>
 #include <QGroupBox>
 #include <QSlider>
 #include <QPushButton>
 #include <QLabel>
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+// 세로 레벨 미터 1개: 막대 = RMS, 가는 선 = peak hold, 맨 위 칸 = 클립 표시.
+// 눈금은 dBFS (-60 ~ 0). 값은 MixerWidget 이 갱신 주기마다 넣어 준다 (full scale = 1.0).
+class LevelMeter : public QWidget {
+public:
+    static const int kFloorDb    = -60;
+    static const int kHoldMs     = 1000;   // peak 표시 유지
+    static const int kFallDbPerS = 24;     // 유지 뒤 떨어지는 속도
+    static const int kClipHoldMs = 2000;
+
+    explicit LevelMeter(QWidget *parent = nullptr) : QWidget(parent) {
+        setMinimumSize(12, 120);
+        setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Expanding);
+    }
+    QSize sizeHint() const override { return QSize(14, 160); }
+
+    void setLevel(float peak, float rms, qint64 nowMs) {
+        const float peakDb = toDb(peak);
+        m_rmsDb = toDb(rms);
+        if (peakDb >= m_holdDb) {
+            m_holdDb = peakDb;
+            m_holdUntilMs = nowMs + kHoldMs;
+        } else if (nowMs > m_holdUntilMs) {
+            m_holdDb = std::max(peakDb, m_holdDb - kFallDbPerS * float(nowMs - m_lastMs) / 1000.f);
+        }
+        if (peak >= 1.f) m_clipUntilMs = nowMs + kClipHoldMs;
+        m_clip = nowMs < m_clipUntilMs;
+        m_lastMs = nowMs;
+        update();
+    }
+
+protected:
+    void paintEvent(QPaintEvent *) override {
+        QPainter p(this);
+        const int clipH = 6;
+        const QRect bar = rect().adjusted(0, clipH + 2, 0, 0);
+        p.fillRect(rect(), QColor(32, 32, 32));
+        p.fillRect(QRect(0, 0, width(), clipH), m_clip ? QColor(230, 40, 40) : QColor(70, 30, 30));
+
+        const int h = int(bar.height() * fraction(m_rmsDb));
+        QLinearGradient g(bar.bottomLeft(), bar.topLeft());
+        g.setColorAt(0.0, QColor(40, 180, 70));
+        g.setColorAt(0.8, QColor(220, 200, 40));   // -12 dB
+        g.setColorAt(1.0, QColor(230, 60, 40));
+        p.fillRect(QRect(bar.left(), bar.bottom() - h + 1, bar.width(), h), g);
+
+        if (m_holdDb > kFloorDb) {
+            const int y = bar.bottom() - int(bar.height() * fraction(m_holdDb));
+            p.fillRect(QRect(bar.left(), y, bar.width(), 2), m_holdDb >= 0.f ? QColor(255, 80, 60) : QColor(235, 235, 235));
+        }
+    }
+
+private:
+    static float toDb(float x) { return x > 1e-6f ? 20.f * std::log10(x) : -120.f; }
+    static float fraction(float db) { return qBound(0.f, (db - kFloorDb) / float(-kFloorDb), 1.f); }
+
+    float  m_rmsDb = -120.f;
+    float  m_holdDb = -120.f;
+    qint64 m_holdUntilMs = 0;
+    qint64 m_clipUntilMs = 0;
+    qint64 m_lastMs = 0;
+    bool   m_clip = false;
+};
 
-MixerWidget::MixerWidget(QWidget *parent) : QWidget(parent) {
+MixerWidget::MixerWidget(AudioEngine *engine, QWidget *parent) : QWidget(parent), m_engine(engine) {
     setLayout(reinterpret_cast<QLayout*>(buildUi()->layout()));
+    connect(&m_meterTimer, &QTimer::timeout, this, &MixerWidget::pollMeters);
 }
 
 QWidget* MixerWidget::buildUi() {
@@ -17,18 +86,19 @@ QWidget* MixerWidget::buildUi() {
     h->setSpacing(18);
     h->setContentsMargins(16,16,16,16);
 
-    // ★ 서버 키와 맞춘 세션명: "Guita" / "Drum" / "Piano"
-    const QStringList sessions = { "Guita", "Drum", "Piano" };
+    // ★ 채널 순서 = BandInstrument (Guita, Drum, Piano)
+    static const char *const sessions[BAND_INST_COUNT] = { "Guita", "Drum", "Piano" };
 
-    for (const QString& s : sessions) {
-        auto *strip = makeChannelStrip(s, 75);
+    for (int ch = 0; ch < BAND_INST_COUNT; ++ch) {
+        auto *strip = makeChannelStrip(QString::fromLatin1(sessions[ch]), ch, 75);
         h->addWidget(strip, 0, Qt::AlignTop);
     }
+    h->addWidget(makeMasterStrip(), 0, Qt::AlignTop);
     h->addStretch(1);
     return w;
 }
 
-QGroupBox* MixerWidget::makeChannelStrip(const QString& sessionName, int initPercent) {
+QGroupBox* MixerWidget::makeChannelStrip(const QString& sessionName, int channel, int initPercent) {
     auto *gb = new QGroupBox(sessionName, this);
     auto *v = new QVBoxLayout(gb);
 
@@ -37,6 +107,7 @@ QGroupBox* MixerWidget::makeChannelStrip(const QString& sessionName, int initPer
 
     auto *slider = new QSlider(Qt::Vertical, gb);
     slider->setObjectName(QStringLiteral("vol_%1").arg(sessionName));
+    slider->setProperty("channel", channel);
     slider->setRange(0, 100);
     slider->setPageStep(5);
     slider->setTickPosition(QSlider::TicksBothSides);
@@ -45,20 +116,26 @@ QGroupBox* MixerWidget::makeChannelStrip(const QString& sessionName, int initPer
 
     auto *mute = new QPushButton(tr("Mute"), gb);
     mute->setObjectName(QStringLiteral("mute_%1").arg(sessionName));
+    mute->setProperty("channel", channel);
     mute->setCheckable(true);
 
+    auto *meter = new LevelMeter(gb);
+    auto *fader = new QHBoxLayout;
+    fader->addWidget(slider, 1);
+    fader->addWidget(meter);
+
     v->addWidget(valueLabel);
-    v->addWidget(slider, 1);
+    v->addLayout(fader, 1);
     v->addSpacing(8);
     v->addWidget(mute);
 
-    m_volSliders.insert(sessionName, slider);
-    m_muteButtons.insert(sessionName, mute);
-    m_valueLabels.insert(sessionName, valueLabel);
+    m_meters[channel]      = meter;
+    m_volSliders[channel]  = slider;
+    m_muteButtons[channel] = mute;
+    m_valueLabels[channel] = valueLabel;
 
-    connect(slider, &QSlider::valueChanged, this, [this, sessionName](int val){
-        if (m_valueLabels.contains(sessionName))
-            m_valueLabels[sessionName]->setText(QString::number(val) + "%");
+    connect(slider, &QSlider::valueChanged, valueLabel, [valueLabel](int val){
+        valueLabel->setText(QString::number(val) + "%");
     });
     connect(slider, &QSlider::valueChanged, this, &MixerWidget::onVolumeChanged);
     connect(mute,   &QPushButton::toggled,  this, &MixerWidget::onMuteToggled);
@@ -66,26 +143,69 @@ QGroupBox* MixerWidget::makeChannelStrip(const QString& sessionName, int initPer
     return gb;
 }
 
+// 마스터: 미터만 (클리핑 전 peak, 잘린 샘플 누적 수)
+QGroupBox* MixerWidget::makeMasterStrip() {
+    auto *gb = new QGroupBox(tr("Master"), this);
+    auto *v = new QVBoxLayout(gb);
+
+    m_masterLabel = new QLabel(QStringLiteral("-inf dB"), gb);
+    m_masterLabel->setAlignment(Qt::AlignHCenter);
+    m_masterMeter = new LevelMeter(gb);
+
+    v->addWidget(m_masterLabel);
+    v->addWidget(m_masterMeter, 1, Qt::AlignHCenter);
+    return gb;
+}
+
+void MixerWidget::showEvent(QShowEvent *e) {
+    QWidget::showEvent(e);
+    if (m_engine) m_meterTimer.start(kMeterPollMs);
+}
+
+void MixerWidget::hideEvent(QHideEvent *e) {
+    m_meterTimer.stop();   // 안 보이면 읽지 않는다 (엔진은 계속 원자값만 덮어씀)
+    QWidget::hideEvent(e);
+}
+
+void MixerWidget::pollMeters() {
+    EngineLevels lv = m_engine->levels();
+    const quint64 clipped = lv.clipped;
+    if (lv.serial != m_lastSerial) {
+        m_lastSerial = lv.serial;
+        m_staleTicks = 0;
+    } else if (++m_staleTicks < kStaleTicks) {
+        return;   // 폴링과 엔진 갱신 주기가 어긋난 것뿐 (다음 틱에 새 값)
+    } else {
+        lv = EngineLevels();   // 한동안 갱신이 없음 = 출력 멈춤 → 무음으로 내려간다
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (int ch = 0; ch < BAND_INST_COUNT; ++ch)
+        m_meters[ch]->setLevel(lv.peak[ch], lv.rms[ch], now);
+    m_masterMeter->setLevel(lv.masterPeak, lv.masterRms, now);
+
+    const QString db = lv.masterPeak > 1e-6f
+        ? QString::number(20.0 * std::log10(double(lv.masterPeak)), 'f', 1) + QStringLiteral(" dB")
+        : QStringLiteral("-inf dB");
+    m_masterLabel->setText(clipped ? db + tr("\nclip %1").arg(clipped) : db);
+}
+
 void MixerWidget::onVolumeChanged(int value) {
     auto *sl = qobject_cast<QSlider*>(sender());
     if (!sl) return;
-    const QString obj = sl->objectName();   // "vol_<Session>"
-    const QString session = obj.mid(4);
-    // qDebug() << "[UI]" << session << "vol=" << value;
-    emit mixerVolume(session, value);
+    const int channel = sl->property("channel").toInt();
+    // qDebug() << "[UI] ch" << channel << "vol=" << value;
+    emit mixerVolume(channel, value);
 }
 
 void MixerWidget::onMuteToggled(bool checked) {
     auto *btn = qobject_cast<QPushButton*>(sender());
     if (!btn) return;
-    const QString obj = btn->objectName();  // "mute_<Session>"
-    const QString session = obj.mid(5);
+    const int channel = btn->property("channel").toInt();
 
-    if (m_volSliders.contains(session))
-        m_volSliders[session]->setEnabled(!checked);
+    if (m_volSliders[channel])
+        m_volSliders[channel]->setEnabled(!checked);
 
-    // qDebug() << "[UI]" << session << "mute=" << checked;
-    emit mixerMute(session, checked);
+    // qDebug() << "[UI] ch" << channel << "mute=" << checked;
+    emit mixerMute(channel, checked);
 }
-
-
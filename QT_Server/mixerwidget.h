@@ -2,34 +2,57 @@
 #define MIXERWIDGET_H
 
 #include <QWidget>
-#include <QMap>
+#include <QTimer>
 
+#include "band_protocol.h"
+
+class AudioEngine;
+class LevelMeter;
 class QSlider;
 class QPushButton;
 class QLabel;
 class QGroupBox;
 
+// 믹서 탭: 채널별 볼륨/뮤트 + 레벨 미터 (채널 버스와 마스터).
+// 미터 값은 엔진이 믹스 루프에서 구해 원자값으로 내놓은 것을 보이는 동안만 타이머로 읽는다.
 class MixerWidget : public QWidget {
     Q_OBJECT
 public:
-    explicit MixerWidget(QWidget *parent = nullptr);
+    static const int kMeterPollMs = 33;   // 엔진 갱신 주기(AudioEngine::kMeterHz)와 맞춤
+    static const int kStaleTicks  = 8;    // 이만큼 연속으로 새 값이 없으면 미터를 내린다
+
+    explicit MixerWidget(AudioEngine *engine, QWidget *parent = nullptr);
 
 signals:
-    // MainWidget에서 ServerWidget 슬롯에 연결한다.
-    void mixerVolume(const QString& session, int volume); // 0~100
-    void mixerMute(const QString& session, bool mute);    // true=뮤트
+    // MainWidget에서 ServerCore 슬롯에 연결한다. channel = BandInstrument
+    void mixerVolume(int channel, int volume); // 0~100
+    void mixerMute(int channel, bool mute);    // true=뮤트
 
 private:
-    QMap<QString, QSlider*>     m_volSliders;
-    QMap<QString, QPushButton*> m_muteButtons;
-    QMap<QString, QLabel*>      m_valueLabels;
+    QSlider*     m_volSliders[BAND_INST_COUNT]  = {};
+    QPushButton* m_muteButtons[BAND_INST_COUNT] = {};
+    QLabel*      m_valueLabels[BAND_INST_COUNT] = {};
+    LevelMeter*  m_meters[BAND_INST_COUNT]      = {};
+    LevelMeter*  m_masterMeter = nullptr;
+    QLabel*      m_masterLabel = nullptr;
+
+    AudioEngine *m_engine = nullptr;
+    QTimer       m_meterTimer;
+    quint32      m_lastSerial = 0;
+    int          m_staleTicks = 0;
 
     QWidget*   buildUi();
-    QGroupBox* makeChannelStrip(const QString& sessionName, int initPercent);
+    QGroupBox* makeChannelStrip(const QString& sessionName, int channel, int initPercent);
+    QGroupBox* makeMasterStrip();
+
+protected:
+    void showEvent(QShowEvent *e) override;
+    void hideEvent(QHideEvent *e) override;
 
 private slots:
     void onVolumeChanged(int value);
     void onMuteToggled(bool checked);
+    void pollMeters();
 };
 
 #endif // MIXERWIDGET_H
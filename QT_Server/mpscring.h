@@ -0,0 +1,62 @@
+#ifndef MPSCRING_H
+#define MPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 다중 생산자/단일 소비자 lock-free 링 버퍼 (칸마다 시퀀스 번호를 두는 bounded 큐).
+// N 은 2의 거듭제곱. push 는 어느 스레드에서든, pop 은 소비자 스레드 하나에서만 호출한다.
+// 생산자끼리는 head 한 번의 CAS 로 칸을 예약하고, 채운 뒤 칸의 시퀀스를 올려 공개한다.
+template <typename T, size_t N>
+class MpscRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+public:
+    MpscRing() {
+        for (size_t i = 0; i < N; ++i) m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    bool push(const T &v) {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &m_cells[pos & (N - 1)];
+            const size_t seq = cell->seq.load(std::memory_order_acquire);
+            const intptr_t diff = intptr_t(seq) - intptr_t(pos);
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;                                    // 가득 참
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);    // 다른 생산자가 먼저 가져감
+            }
+        }
+        cell->data = v;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &out) {
+        const size_t pos = m_tail.load(std::memory_order_relaxed);
+        Cell &cell = m_cells[pos & (N - 1)];
+        if (cell.seq.load(std::memory_order_acquire) != pos + 1) return false;   // 비었거나 아직 쓰는 중
+        out = cell.data;
+        cell.seq.store(pos + N, std::memory_order_release);
+        m_tail.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T data;
+    };
+    Cell m_cells[N];
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+};
+
+#endif // MPSCRING_H
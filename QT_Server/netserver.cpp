@@ -0,0 +1,641 @@
+#include "netserver.h"
+#include "cmdparser.h"
+#include "serverlog.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <QRandomGenerator>
+#include <cstdio>
+#include <cstring>
+
+NetServer::NetServer(AudioEngine *engine, RecvLog *recvLog, TempoGrid *tempo, JitterConfig *jitter,
+                     QObject *parent)
+    : QObject(parent)
+    , m_engine(engine)
+    , m_recvLog(recvLog)
+    , m_tempo(tempo)
+    , m_jitterCfg(jitter)
+{
+}
+
+NetServer::~NetServer()
+{
+    stopServer();
+}
+
+bool NetServer::loadIdPassFile()
+{
+    idpw.clear();
+
+    QFile f(":/idpasswd.txt");    // ✅ 리소스 경로
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "idpasswd.txt open fail (resource)";
+        return false;
+    }
+
+    QTextStream ts(&f);
+    while (!ts.atEnd()) {
+        const QString line = ts.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) continue;
+        const auto parts = line.split(QRegExp("\\s+"), Qt::SkipEmptyParts);
+        if (parts.size() >= 2) idpw.insert(parts[0], parts[1]);
+    }
+
+    qInfo() << "Loaded" << idpw.size() << "id/pass entries (from resource)";
+    return true;
+}
+
+bool NetServer::checkAuth(const QString &id, const QString &pw) const
+{
+    auto it = idpw.constFind(id);
+    return (it != idpw.constEnd() && it.value() == pw);
+}
+
+bool NetServer::startServer()
+{
+    if (running) return false;
+    loadIdPassFile();
+
+    server = new QTcpServer(this);
+    if (!server->listen(QHostAddress::Any, m_port)) {
+        qWarning() << "Server listen failed:" << server->errorString();
+        server->deleteLater();
+        server = nullptr;
+        return false;
+    }
+
+    connect(server, &QTcpServer::newConnection, this, &NetServer::onNewConnection);
+
+    // UDP 는 선택 기능이라 bind 실패해도 TCP 서버는 계속 돈다
+    m_udp = new QUdpSocket(this);
+    if (m_udp->bind(QHostAddress::Any, m_port)) {
+        connect(m_udp, &QUdpSocket::readyRead, this, &NetServer::onUdpReadyRead);
+    } else {
+        qWarning() << "[UDP] bind failed:" << m_udp->errorString() << "-> TCP only";
+        m_udp->deleteLater();
+        m_udp = nullptr;
+    }
+
+    m_statsTimer = new QTimer(this);
+    connect(m_statsTimer, &QTimer::timeout, this, &NetServer::publishClientStats);
+    connect(m_statsTimer, &QTimer::timeout, this, &NetServer::expireSessions);
+    m_statsTimer->start(CLIENT_STATS_MS);
+
+    openJournal();
+
+    running = true;
+    qInfo() << "NetServer started on port" << m_port << (m_udp ? "(tcp+udp)" : "(tcp)");
+    return true;
+}
+
+// 저널은 켰을 때만 기록한다: QT_SERVER_JOURNAL=1 (<실행파일 폴더>/journal/<시작 시각>) 또는 =<prefix>
+// 총 크기 상한 QT_SERVER_JOURNAL_MAX_MB (기본 JOURNAL_MAX_MB_DEFAULT). 닿으면 기록을 멈춘다
+void NetServer::openJournal()
+{
+    QString prefix = QString::fromLocal8Bit(qgetenv("QT_SERVER_JOURNAL"));
+    if (prefix.isEmpty() || prefix == QLatin1String("off") || prefix == QLatin1String("0")) return;
+    if (prefix == QLatin1String("1") || prefix == QLatin1String("on")) {
+        const QString dir = QCoreApplication::applicationDirPath() + QStringLiteral("/journal");
+        QDir().mkpath(dir);
+        prefix = dir + QLatin1Char('/') + QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss"));
+    }
+    bool ok = false;
+    qint64 maxMb = qEnvironmentVariableIntValue("QT_SERVER_JOURNAL_MAX_MB", &ok);
+    if (!ok || maxMb <= 0) maxMb = JOURNAL_MAX_MB_DEFAULT;
+    const uint32_t maxSegments = uint32_t(qMax<qint64>(1, maxMb * 1024 * 1024 / qint64(EventJournal::segmentBytes())));
+
+    std::string err;
+    if (m_journal.open(QFile::encodeName(prefix).toStdString(), maxSegments, &err))
+        qInfo() << "[JOURNAL] ->" << QString::fromStdString(m_journal.path()) << "max" << maxSegments << "segments";
+    else
+        qWarning() << "[JOURNAL] open fail:" << QString::fromStdString(err) << "-> not recording";
+}
+
+void NetServer::stopServer()
+{
+    if (!running) return;
+    running = false;
+
+    for (auto it = clients.begin(); it != clients.end(); ++it) {
+        if (it.key()) {
+            it.key()->disconnect(this);
+            it.key()->close();
+            it.key()->deleteLater();
+        }
+    }
+    clients.clear();
+    m_udpKeys.clear();
+    m_sessions.clear();
+
+    if (m_statsTimer) {
+        m_statsTimer->stop();
+        m_statsTimer->deleteLater();
+        m_statsTimer = nullptr;
+    }
+    m_lastStats.clear();
+    emit clientStatsSig(QString());
+    if (m_udp) {
+        m_udp->close();
+        m_udp->deleteLater();
+        m_udp = nullptr;
+    }
+
+    const EngineQueueStats qs = m_engine->queueStats();
+    qInfo() << "[QUEUE] posted" << qs.posted << "dropped" << qs.dropped
+            << "depthMax" << qs.depthMax << "wait(us) avg" << qs.waitAvgUs << "max" << qs.waitMaxUs;
+    qInfo() << "[LOG] written" << ServerLog::written() << "dropped" << ServerLog::dropped();
+    if (m_journal.isOpen() || m_journal.failed()) {
+        qInfo() << "[JOURNAL] records" << m_journal.written() << "segments" << m_journal.segments()
+                << "failed" << m_journal.failed() << "last" << QString::fromStdString(m_journal.path());
+        m_journal.close();
+    }
+
+    if (server) {
+        server->close();
+        server->deleteLater();
+        server = nullptr;
+    }
+    qInfo() << "NetServer stopped";
+}
+
+void NetServer::onNewConnection() {
+    while (server->hasPendingConnections()) {
+        QTcpSocket *sock = server->nextPendingConnection();
+        sock->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        sock->setParent(this);
+        clients.insert(sock, Client{});                   // sock을 키로 상태 저장
+        clients[sock].ip = sock->peerAddress().toString();
+        clients[sock].sock = sock;
+        clients[sock].connectNs = monoNowNs();
+
+        connect(sock, &QTcpSocket::readyRead,    this, &NetServer::onReadyRead);
+        connect(sock, &QTcpSocket::disconnected, this, &NetServer::onDisconnected);
+
+        sock->write("Welcome. Please login with 'id:pw'\n");
+    }
+}
+
+void NetServer::onDisconnected()
+{
+    auto *sock = qobject_cast<QTcpSocket*>(sender());
+    if (!sock) return;
+    auto it = clients.find(sock);
+    if (it != clients.end()) {
+        qInfo() << "[DISCONNECT]" << it->ip << (it->authed ? it->id : "(unauth)");
+        if (it->binary)
+            qInfo() << "[BIN]" << it->id << "records" << it->records << "lastSeq" << it->lastSeq
+                    << "seqGaps" << it->seqGaps;
+        if (it->udpKey) {
+            const SeqWindow::Stats &s = it->udpWin.stats();
+            qInfo() << "[UDP]" << it->id << "recv" << s.received << "accepted" << s.accepted
+                    << "dup" << s.duplicates << "reordered" << s.reordered << "late" << s.late << "lost" << s.lost;
+        }
+        if (it->authed && it->session) parkSession(*it);          // 재접속용으로 보관 (UDP key 유지)
+        else if (it->udpKey) m_udpKeys.remove(it->udpKey);
+        clients.erase(it);
+    }
+    sock->deleteLater();
+}
+
+void NetServer::onReadyRead()
+{
+    auto *sock = qobject_cast<QTcpSocket*>(sender());
+    if (!sock) return;
+    auto it = clients.find(sock);
+    if (it == clients.end()) return;
+    Client &c = it.value();
+
+    const qint64 rxNs = monoNowNs();   // 이 묶음의 수신 시각
+
+    // 소켓에서 rxBuf 뒤에 바로 읽어 붙임 (readAll 임시 버퍼 없음)
+    const qint64 avail = sock->bytesAvailable();
+    if (avail <= 0) return;
+    const int old = c.rxBuf.size();
+    c.rxBuf.resize(old + int(avail));
+    const qint64 got = sock->read(c.rxBuf.data() + old, avail);
+    c.rxBuf.resize(old + int(qMax<qint64>(got, 0)));
+
+    // 읽기 커서로 스캔. 버퍼 앞부분 제거는 마지막에 한 번만 (O(N))
+    // 텍스트 라인 도중 [PROTO]BIN1 을 만나면 바로 다음 바이트부터 바이너리 레코드로 해석한다.
+    const char *base = c.rxBuf.constData();
+    const int size = c.rxBuf.size();
+    int pos = 0;
+    while (pos < size && !c.dropping) {
+        if (c.binary) {
+            BandEventRecord rec;
+            if (size - pos < int(sizeof(BandEventRecord))) break;
+            if (!band_read_event(base + pos, size_t(size - pos), rec)) {
+                qWarning() << "[BIN] bad record from" << c.ip << c.id << "-> disconnect";
+                c.dropping = true;
+                break;
+            }
+            pos += int(sizeof(BandEventRecord));
+            handleRecord(c, rec, rxNs);
+            continue;
+        }
+
+        const char *nl = static_cast<const char*>(memchr(base + pos, '\n', size_t(size - pos)));
+        if (!nl) break;
+        const int end = int(nl - base);          // '\n' 위치
+        int lineEnd = end;
+        if (lineEnd > pos && base[lineEnd - 1] == '\r') --lineEnd;
+
+        // 1) 내부 처리 먼저 (노트는 엔진 큐로 바로 들어감)
+        handleLine(c, base + pos, lineEnd - pos, rxNs);
+
+        // 2) 수신 로그 링에 원본 그대로 복사 (UI 는 자기 주기로 가져감, 타격 이후)
+        if (m_recvLog) m_recvLog->push(rxNs, base + pos, lineEnd - pos);
+
+        pos = end + 1;
+    }
+
+    if (c.dropping) {
+        // readyRead 안에서 바로 끊으면 disconnected 가 동기로 불려 c 가 사라지므로 다음 루프로 미룸
+        c.rxBuf.clear();
+        QMetaObject::invokeMethod(sock, "abort", Qt::QueuedConnection);
+        return;
+    }
+    if (pos > 0) c.rxBuf.remove(0, pos);
+    if (!c.binary && c.rxBuf.size() > MAX_LINE_BYTES) {   // 개행 없는 쓰레기 입력 방어
+        SLOG_WARN("rx.line_too_long", nullptr, 0, {{"bytes", c.rxBuf.size()}});
+        c.rxBuf.clear();
+    }
+}
+
+// 태그 → 핸들러 고정 테이블 (대문자 이름, 길이 비교 후 대소문자 무시 비교)
+const NetServer::TagHandler NetServer::kTagTable[] = {
+    { "PIANO", 5, &NetServer::handlePiano },
+    { "DRUM",  4, &NetServer::handleDrum  },
+    { "GUITA", 5, &NetServer::handleGuita },
+    { "PROTO", 5, &NetServer::handleProto },
+    { "PING",  4, &NetServer::handlePing  },
+    { "STATS", 5, &NetServer::handleStats },
+};
+
+// 악기 번호(BandInstrument) → 믹서 키
+static const char *const kChannelKey[BAND_INST_COUNT] = { "GUITA", "DRUM", "PIANO" };
+
+void NetServer::handleLine(Client &c, const char *line, int len, qint64 rxNs)
+{
+    // 0) 로그인 먼저 처리하고 종료 (접속당 1회라 QString 사용)
+    if (!c.authed) {
+        const int rl = int(sizeof(BAND_RESUME_CMD)) - 1;
+        if (len > rl && std::memcmp(line, BAND_RESUME_CMD, size_t(rl)) == 0) {
+            c.sock->write(resumeSession(c, line + rl, len - rl) ? BAND_RESUME_OK "\n" : BAND_RESUME_FAIL "\n");
+            return;
+        }
+        const QString s = QString::fromUtf8(line, len).trimmed();
+        if (s.isEmpty()) return;
+        const int p = s.indexOf(':');
+        if (p > 0) {
+            const QString id = s.left(p).trimmed();
+            const QString pw = s.mid(p+1).trimmed();
+            qDebug() << "[LOGIN try]" << c.ip << id;
+            if (checkAuth(id, pw)) {
+                c.authed = true;
+                c.id = id;
+                qInfo() << "[LOGIN OK]" << c.ip << c.id;
+                // 재접속 때 쓸 세션 토큰 (옛 클라이언트는 이 줄을 읽지 않아도 무방)
+                do { c.session = QRandomGenerator::global()->generate64(); }
+                while (c.session == 0 || m_sessions.contains(c.session));
+                c.sock->write(QByteArray(BAND_SESSION_REPLY) + QByteArray::number(c.session, 16) + '\n');
+            } else {
+                qWarning() << "[LOGIN FAIL]" << c.ip << id;
+                // sock->write("Auth Error\n"); sock->disconnectFromHost();
+            }
+        } else {
+            qWarning() << "[LOGIN WAIT] expecting id:pw, got" << s.size() << "chars";
+        }
+        return;  // 🔴 로그인 라인은 여기서 끝!
+    }
+
+    // 1) 여기서부터 명령 파싱 ([TAG]payload 또는 TAG:payload) — 버퍼 안에서 뷰만 만든다
+    CmdView cmd;
+    if (!parseCommand(line, len, cmd)) {
+        bool blank = true;
+        for (int i = 0; i < len && blank; ++i) blank = cmdIsSpace(line[i]);
+        if (!blank) SLOG_WARN("rx.unrecognized", line, len);
+        return;
+    }
+
+    SLOG_DEBUG("parse", line, len, {{"tagLen", cmd.tagLen}, {"payloadLen", cmd.payloadLen}});
+
+    for (const TagHandler &h : kTagTable) {
+        if (cmdTagEquals(cmd.tag, cmd.tagLen, h.name, h.len)) {
+            (this->*h.fn)(c, cmd.payload, cmd.payloadLen, rxNs);
+            return;
+        }
+    }
+
+    SLOG_INFO("rx.unknown_tag", cmd.tag, cmd.tagLen, {{"payloadLen", cmd.payloadLen}});
+}
+
+void NetServer::handleRecord(Client &c, const BandEventRecord &rec, qint64 rxNs)
+{
+    if (!c.authed) return;   // 협상은 로그인 후에만 가능하므로 방어용
+
+    ++c.records;
+    if (c.lastSeq != 0 && rec.seq > c.lastSeq + 1)
+        c.seqGaps += rec.seq - c.lastSeq - 1;          // 손실(또는 순서 뒤바뀜) 추정
+    if (rec.seq > c.lastSeq) c.lastSeq = rec.seq;
+
+    playNote(c, rec.instrument, rec.note, rec.velocity, rxNs, JOURNAL_BIN, rec.seq, rec.clientTsUs);
+
+    logRecord(rec, rxNs, "");
+}
+
+// 바이너리/UDP 레코드를 텍스트 한 줄로 수신 로그에 남긴다 (스택 버퍼, 할당 없음)
+void NetServer::logRecord(const BandEventRecord &rec, qint64 rxNs, const char *suffix)
+{
+    if (!m_recvLog) return;
+    char line[96];
+    const int n = std::snprintf(line, sizeof(line), "[%s]%d #%u%s",
+                                kChannelKey[rec.instrument], int(rec.note), unsigned(rec.seq), suffix);
+    m_recvLog->push(rxNs, line, qMin(n, int(sizeof(line)) - 1));
+}
+
+void NetServer::handleProto(Client &c, const char *payload, int len, qint64 rxNs)
+{
+    Q_UNUSED(rxNs);
+    if (cmdTagEquals(payload, len, "BIN1", 4)) {
+        c.binary = true;
+        c.sock->write(BAND_PROTO_BIN_OK);
+        qInfo() << "[PROTO]" << c.ip << c.id << "switched to binary records";
+        return;
+    }
+    if (cmdTagEquals(payload, len, "UDP1", 4)) {
+        if (!m_udp) { qWarning() << "[PROTO] UDP requested but socket not bound"; return; }
+        if (!c.udpKey) {
+            quint32 key;
+            do { key = QRandomGenerator::global()->generate(); } while (key == 0 || m_udpKeys.contains(key));
+            c.udpKey = key;
+            c.peer = c.sock->peerAddress();
+            m_udpKeys.insert(key, c.sock);
+        }
+        c.sock->write(QByteArray(BAND_PROTO_UDP_REPLY) + QByteArray::number(m_port) + ' '
+                      + QByteArray::number(c.udpKey, 16) + '\n');
+        qInfo() << "[PROTO]" << c.ip << c.id << "udp events enabled";
+        return;
+    }
+    qWarning() << "[PROTO] unsupported:" << QByteArray::fromRawData(payload, len);
+}
+
+void NetServer::onUdpReadyRead()
+{
+    const qint64 rxNs = monoNowNs();
+    char buf[64];
+    QHostAddress from;
+    while (m_udp && m_udp->hasPendingDatagrams()) {
+        const qint64 n = m_udp->readDatagram(buf, sizeof(buf), &from);
+        if (n > 0) handleDatagram(buf, int(n), from, rxNs);
+    }
+}
+
+void NetServer::handleDatagram(const char *data, int len, const QHostAddress &from, qint64 rxNs)
+{
+    BandUdpDatagram d;
+    if (len != int(sizeof(d))) return;                  // 크기가 다르면 조용히 버림 (스캔/잡음)
+    std::memcpy(&d, data, sizeof(d));
+
+    auto k = m_udpKeys.constFind(band_le32(d.key));
+    if (k == m_udpKeys.cend()) return;
+    auto it = clients.find(k.value());
+    if (it == clients.end()) return;
+    Client &c = it.value();
+    if (!c.peer.isEqual(from, QHostAddress::TolerantConversion)) return;   // key 도용 방지
+
+    BandEventRecord rec;
+    if (!band_read_event(&d.rec, sizeof(d.rec), rec)) return;
+
+    const SeqWindow::Verdict v = c.udpWin.offer(rec.seq, rec.clientTsUs, quint64(UDP_LATE_DEADLINE_MS) * 1000);
+    if (v == SeqWindow::Duplicate || v == SeqWindow::Late) return;
+
+    playNote(c, rec.instrument, rec.note, rec.velocity, rxNs, JOURNAL_UDP, rec.seq, rec.clientTsUs);
+
+    logRecord(rec, rxNs, v == SeqWindow::AcceptReordered ? " (udp, reordered)" : " (udp)");
+}
+
+// 끊긴 연결의 상태를 토큰으로 보관. UDP key 는 nullptr 로 예약해 두어 그 사이 데이터그램은 버리고
+// 다른 연결에 재발급되지 않게 한다.
+void NetServer::parkSession(Client &c)
+{
+    ParkedSession p;
+    p.id       = c.id;
+    p.binary   = c.binary;
+    p.lastSeq  = c.lastSeq;
+    p.records  = c.records;
+    p.seqGaps  = c.seqGaps;
+    p.udpKey   = c.udpKey;
+    p.udpWin   = c.udpWin;
+    p.jitter   = c.jitter;     // 같은 클라이언트 프로세스면 시계 차이(base)도 그대로 유효
+    p.parkedNs = monoNowNs();
+    if (c.udpKey) m_udpKeys.insert(c.udpKey, nullptr);
+    m_sessions.insert(c.session, p);
+}
+
+// "RESUME:<token>" 한 줄로 ID, 프로토콜 모드, seq 상태, UDP key 를 새 연결에 옮긴다.
+// 이전 연결이 아직 살아 있다고 보이는 경우(반쯤 끊긴 TCP)에는 그 연결에서 빼앗고 끊는다.
+bool NetServer::resumeSession(Client &c, const char *token, int len)
+{
+    bool ok = false;
+    const quint64 t = QByteArray::fromRawData(token, len).trimmed().toULongLong(&ok, 16);
+    if (!ok || t == 0) return false;
+
+    auto p = m_sessions.find(t);
+    if (p == m_sessions.end()) {
+        for (auto it = clients.begin(); it != clients.end(); ++it) {
+            Client &old = it.value();
+            if (&old == &c || old.session != t) continue;
+            parkSession(old);
+            old.session = 0;
+            old.udpKey  = 0;
+            old.authed  = false;
+            QMetaObject::invokeMethod(old.sock, "abort", Qt::QueuedConnection);
+            p = m_sessions.find(t);
+            break;
+        }
+        if (p == m_sessions.end()) {
+            qWarning() << "[RESUME FAIL]" << c.ip << "unknown or expired session";
+            return false;
+        }
+    }
+
+    c.authed  = true;
+    c.resumed = true;
+    c.session = t;
+    c.id      = p->id;
+    c.binary  = p->binary;
+    c.lastSeq = p->lastSeq;
+    c.records = p->records;
+    c.seqGaps = p->seqGaps;
+    c.udpKey  = p->udpKey;
+    c.udpWin  = p->udpWin;
+    c.jitter  = p->jitter;
+    if (c.udpKey) {
+        c.peer = c.sock->peerAddress();
+        m_udpKeys.insert(c.udpKey, c.sock);
+    }
+    qInfo() << "[RESUME]" << c.ip << c.id << "after" << (monoNowNs() - p->parkedNs) / 1000000 << "ms"
+            << (c.binary ? "(bin)" : "") << (c.udpKey ? "(udp)" : "");
+    m_sessions.erase(p);
+    return true;
+}
+
+void NetServer::expireSessions()
+{
+    const qint64 now = monoNowNs();
+    for (auto it = m_sessions.begin(); it != m_sessions.end(); ) {
+        if (now - it->parkedNs < qint64(BAND_SESSION_TTL_MS) * 1000000) { ++it; continue; }
+        if (it->udpKey) m_udpKeys.remove(it->udpKey);
+        it = m_sessions.erase(it);
+    }
+}
+
+// 클라이언트별 seq 카운터 + 지터/재생 지연을 한 줄씩. 바뀐 게 없으면 보내지 않는다.
+void NetServer::publishClientStats()
+{
+    const auto ms = [](quint32 us) { return QString::number(us / 1000.0, 'f', 1); };
+    QString text;
+    for (auto it = clients.cbegin(); it != clients.cend(); ++it) {
+        const Client &c = it.value();
+        if (!c.authed) continue;
+        if (c.udpKey) {
+            const SeqWindow::Stats &s = c.udpWin.stats();
+            text += QStringLiteral("%1 UDP  ok %2  lost %3  reordered %4  late %5  dup %6")
+                        .arg(c.id).arg(s.accepted).arg(s.lost).arg(s.reordered).arg(s.late).arg(s.duplicates);
+        } else if (c.binary) {
+            text += QStringLiteral("%1 BIN  ok %2  gaps %3").arg(c.id).arg(c.records).arg(c.seqGaps);
+        } else {
+            text += QStringLiteral("%1 TEXT\n").arg(c.id);   // 클라이언트 시각이 없어 지터 추정 불가
+            continue;
+        }
+        const JitterBuffer::Stats &j = c.jitter.stats();
+        if (j.events)
+            text += QStringLiteral("  jitter %1 ms  spread %2 ms  delay %3/%4 ms  playLate %5")
+                        .arg(ms(j.jitterUs)).arg(ms(j.maxExcessUs)).arg(ms(j.delayUs)).arg(ms(j.targetUs)).arg(j.late);
+        text += QLatin1Char('\n');
+    }
+    text.chop(1);
+
+    if (text == m_lastStats) return;
+    m_lastStats = text;
+    emit clientStatsSig(text);
+}
+
+// 왕복 시간 측정용: 페이로드를 그대로 돌려준다 ("[PING]abc" → "PONG abc")
+// 같은 연결의 앞선 이벤트가 모두 처리된 뒤에 응답하므로 서버 처리 지연이 포함된다.
+void NetServer::handlePing(Client &c, const char *payload, int len, qint64 rxNs)
+{
+    Q_UNUSED(rxNs);
+    QByteArray out;
+    out.reserve(len + 6);
+    out.append("PONG ", 5).append(payload, len).append('\n');
+    c.sock->write(out);
+}
+
+// 부하 테스트용 엔진 큐 계측값 한 줄
+void NetServer::handleStats(Client &c, const char *payload, int len, qint64 rxNs)
+{
+    Q_UNUSED(payload); Q_UNUSED(len); Q_UNUSED(rxNs);
+    const EngineQueueStats qs = m_engine->queueStats();
+    c.sock->write(QStringLiteral("STATS posted=%1 dropped=%2 consumed=%3 depthMax=%4 waitAvgUs=%5 waitMaxUs=%6 clients=%7 logDropped=%8 schedLate=%9\n")
+                  .arg(qs.posted).arg(qs.dropped).arg(qs.consumed).arg(qs.depthMax)
+                  .arg(qs.waitAvgUs).arg(qs.waitMaxUs).arg(clients.size())
+                  .arg(ServerLog::dropped()).arg(qs.schedLate).toLatin1());
+}
+
+void NetServer::handlePiano(Client &c, const char *payload, int len, qint64 rxNs)
+{
+    const int note = (len > 0) ? band_note_from_char(BAND_INST_PIANO, payload[0]) : -1;
+    if (note < 0) { SLOG_WARN("piano.invalid", payload, len); return; }
+    playNote(c, BAND_INST_PIANO, note, BAND_VELOCITY_DEFAULT, rxNs);
+}
+
+void NetServer::handleGuita(Client &c, const char *payload, int len, qint64 rxNs)
+{
+    const int note = (len > 0) ? band_note_from_char(BAND_INST_GUITA, payload[0]) : -1;
+    if (note < 0) { SLOG_WARN("guita.invalid", payload, len); return; }
+    playNote(c, BAND_INST_GUITA, note, BAND_VELOCITY_DEFAULT, rxNs);
+}
+
+void NetServer::handleDrum(Client &c, const char *payload, int len, qint64 rxNs)
+{
+    int v = -1, vel = BAND_VELOCITY_DEFAULT;
+    // 0:tom_hi 1:tom_mid 2:cymbal_left 3:kick 4:cymbal_right, 뒤에 ",<velocity 1~127>" 선택
+    const char *comma = static_cast<const char*>(std::memchr(payload, ',', size_t(len)));
+    const int noteLen = comma ? int(comma - payload) : len;
+    if (!cmdParseUInt(payload, noteLen, v) || v >= BAND_NOTE_COUNT[BAND_INST_DRUM]
+        || (comma && (!cmdParseUInt(comma + 1, len - noteLen - 1, vel) || vel > BAND_VELOCITY_MAX))) {
+        SLOG_WARN("drum.invalid", payload, len);
+        return;
+    }
+    playNote(c, BAND_INST_DRUM, v, vel, rxNs);
+}
+
+// 텍스트/바이너리 공통: 악기+노트 → 샘플, 속도 게인. 채널 음량은 엔진이 버스 게인 램프로 곱한다.
+// 여기 들어온 시점 = 파싱/검증 완료 (지연 측정의 parse 시각)
+// seq/clientTsUs: BIN/UDP 레코드 값 (텍스트는 0 → 저널은 연결별 번호, 지터 버퍼 없이 수신 시각 기준)
+void NetServer::playNote(Client &c, int instrument, int note, int velocity, qint64 rxNs,
+                         quint8 transport, quint32 seq, quint64 clientTsUs)
+{
+    const qint64 parseNs = monoNowNs();
+    if (!c.noteSeen) {
+        // 연결(accept) → 첫 노트. 재접속 직후 밀린 타격을 바로 보내는 클라이언트라면 재접속 비용 그 자체
+        c.noteSeen = true;
+        qInfo() << "[SESSION]" << c.id << (c.resumed ? "resume" : "login")
+                << "connect -> first note" << (parseNs - c.connectNs) / 1000 << "us";
+    }
+
+    // 저널은 믹서 상태(mute)와 무관하게 수락한 입력을 그대로 남긴다 (재생/렌더 때 다시 적용)
+    if (m_journal.isOpen()) {
+        if (!c.journalId[0]) {
+            const QByteArray id = c.id.toUtf8();
+            std::memcpy(c.journalId, id.constData(), size_t(qMin(id.size(), int(sizeof(c.journalId)))));
+        }
+        JournalRecord jr;
+        jr.rxNs       = rxNs;
+        jr.clientTsUs = clientTsUs;
+        jr.seq        = (transport == JOURNAL_TEXT) ? ++c.textSeq : seq;
+        jr.instrument = quint8(instrument);
+        jr.note       = quint8(note);
+        jr.velocity   = quint8(velocity);
+        jr.transport  = transport;
+        std::memcpy(jr.clientId, c.journalId, sizeof(jr.clientId));
+        m_journal.append(jr);
+    }
+    if (m_engine->channelMuted(instrument)) { SLOG_DEBUG("audio.muted", nullptr, 0, {{"ch", instrument}}); return; }
+
+    const float gain = velocityGain(velocity);
+
+    // 지터 버퍼: 클라이언트가 보낸 간격을 되살린 도착 시각 (꺼져 있거나 늦게 온 이벤트는 rxNs 그대로)
+    qint64 dueNs = rxNs;
+    if (clientTsUs && m_jitterCfg) {
+        dueNs = c.jitter.playout(rxNs, clientTsUs, *m_jitterCfg);
+        if (dueNs != rxNs) SLOG_TRACE("jitter", nullptr, 0, {{"ch", instrument}, {"holdUs", (dueNs - rxNs) / 1000}});
+    }
+
+    // 퀀타이즈 켜짐: 그 시각을 가장 가까운 그리드 선 쪽으로 옮겨 미래 프레임에 예약
+    int64_t shiftNs = 0;
+    qint64 playNs = m_tempo ? m_tempo->schedule(instrument, dueNs, &shiftNs) : 0;
+    if (playNs) SLOG_DEBUG("quantize", nullptr, 0, {{"ch", instrument}, {"shiftUs", shiftNs / 1000}});
+    else if (dueNs != rxNs) playNs = dueNs;
+
+    postNote(kSampleBase[instrument] + note, instrument, gain, rxNs, parseNs, playNs);
+}
+
+void NetServer::postNote(int sampleId, int channel, float gain, qint64 rxNs, qint64 parseNs, qint64 playNs)
+{
+    NoteEvent ev;
+    ev.rxNs    = rxNs;
+    ev.parseNs = parseNs;
+    ev.gain    = gain;
+    ev.sample  = quint8(sampleId);
+    ev.channel = quint8(channel);
+    ev.playNs  = playNs;
+    ev.queueNs = monoNowNs();
+    if (!m_engine->post(ev))
+        SLOG_WARN("audio.queue_full", nullptr, 0, {{"sample", sampleId}});
+}
@@ -0,0 +1,151 @@
+#ifndef NETSERVER_H
+#define NETSERVER_H
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUdpSocket>
+#include <QTimer>
+#include <QHash>
+
+#include "audioengine.h"
+#include "band_protocol.h"
+#include "eventjournal.h"
+#include "jitterbuffer.h"
+#include "recvlog.h"
+#include "seqwindow.h"
+#include "tempogrid.h"
+
+#define PORT 5000
+#define BLOCK_SIZE 1024
+#define MAX_LINE_BYTES 4096   // 개행 없이 이보다 길게 쌓이면 버림
+#define UDP_LATE_DEADLINE_MS 40   // 역순 도착 UDP 이벤트 허용 지연 (넘으면 치는 것보다 버리는 게 낫다)
+#define CLIENT_STATS_MS 1000      // 클라이언트별 손실/역순 카운터 UI 갱신 주기
+#define JOURNAL_MAX_MB_DEFAULT 1024  // 이벤트 저널 총 크기 상한 (QT_SERVER_JOURNAL_MAX_MB 로 변경)
+
+// 소켓 계층: QTcpServer + 로그인 + 라인 파싱 + 엔진 큐 투입.
+// ServerCore 가 전용 네트워크 스레드로 moveToThread 해서 쓰므로 GUI 이벤트 루프
+// (로그 QTextEdit, 믹서 슬라이더 repaint)가 바빠도 readyRead 처리가 밀리지 않는다.
+// 외부와는 시그널/슬롯(queued), 엔진 SPSC 큐, 수신 로그 링(RecvLog)으로만 통신한다.
+// 같은 포트의 QUdpSocket 으로 노트 이벤트를 받을 수도 있다 (로그인/제어는 TCP 유지).
+class NetServer : public QObject
+{
+    Q_OBJECT
+public:
+    NetServer(AudioEngine *engine, RecvLog *recvLog, TempoGrid *tempo, JitterConfig *jitter,
+              QObject *parent = nullptr);
+    ~NetServer() override;
+
+    // TCP/UDP 포트 (기본 PORT). moveToThread 전, startServer 전에만 호출
+    void setPort(quint16 port) { m_port = port; }
+    quint16 port() const { return m_port; }
+
+public slots:
+    bool startServer();
+    void stopServer();
+
+signals:
+    void clientStatsSig(const QString &text);   // 클라이언트별 seq 카운터 요약 (여러 줄)
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+    void onUdpReadyRead();
+    void publishClientStats();
+    void expireSessions();
+
+private:
+    AudioEngine *m_engine = nullptr;   // post() (SPSC 생산자 = 이 스레드) + 채널 mute 조회
+    RecvLog     *m_recvLog = nullptr;  // 수신 줄 → UI (SPSC 생산자 = 이 스레드)
+    TempoGrid   *m_tempo = nullptr;    // 퀀타이즈 설정 (GUI 가 씀) + 이동량 통계 (이 스레드가 씀)
+    JitterConfig *m_jitterCfg = nullptr;   // 재생 지연 설정 (GUI 가 씀)
+
+    struct Client {
+        QString id;
+        QString ip;
+        bool authed = false;
+        QByteArray rxBuf;
+        QTcpSocket *sock = nullptr;
+        bool dropping = false;      // 프로토콜 오류 → 끊기 예약됨
+
+        // 바이너리 프로토콜 (band_protocol.h)
+        bool    binary  = false;
+        quint32 lastSeq = 0;
+        quint64 records = 0;
+        quint64 seqGaps = 0;        // 건너뛴 seq 개수 (손실 추정)
+
+        // UDP 이벤트 전송
+        quint32   udpKey = 0;       // 0 = UDP 미사용
+        QHostAddress peer;          // UDP 송신 주소 확인용
+        SeqWindow udpWin;
+
+        // 클라이언트 시각(BIN/UDP 레코드)이 있을 때 도착 지터 추정 + 재생 지연
+        JitterBuffer jitter;
+
+        // 이벤트 저널
+        quint32 textSeq = 0;                    // 텍스트 노트 번호 (BIN/UDP 는 레코드 seq)
+        char    journalId[kJournalIdLen] = {};  // c.id 를 첫 노트 때 한 번 변환
+
+        // 세션 (band_protocol.h 4) — 재접속 시 RESUME:<token> 으로 위 상태를 되살린다
+        quint64 session   = 0;      // 로그인 때 발급, 0 = 없음
+        bool    resumed   = false;
+        qint64  connectNs = 0;      // accept 시각 (재접속 → 첫 노트 측정)
+        bool    noteSeen  = false;
+    };
+
+    // 끊긴 연결에서 떼어 보관하는 상태 (BAND_SESSION_TTL_MS 동안)
+    struct ParkedSession {
+        QString   id;
+        bool      binary  = false;
+        quint32   lastSeq = 0;
+        quint64   records = 0;
+        quint64   seqGaps = 0;
+        quint32   udpKey  = 0;
+        SeqWindow udpWin;
+        JitterBuffer jitter;
+        qint64    parkedNs = 0;
+    };
+
+    bool loadIdPassFile();
+    void openJournal();
+    bool checkAuth(const QString &id, const QString &pw) const;
+    // 라인/페이로드는 rxBuf 안을 가리키는 포인터 (복사 없음)
+    void handleLine(Client &c, const char *line, int len, qint64 rxNs);
+    void handleRecord(Client &c, const BandEventRecord &rec, qint64 rxNs);
+    void handleGuita(Client &c, const char *payload, int len, qint64 rxNs);
+    void handleDrum(Client &c, const char *payload, int len, qint64 rxNs);
+    void handlePiano(Client &c, const char *payload, int len, qint64 rxNs);
+    void handleProto(Client &c, const char *payload, int len, qint64 rxNs);
+    void handlePing(Client &c, const char *payload, int len, qint64 rxNs);
+    void handleStats(Client &c, const char *payload, int len, qint64 rxNs);
+    void handleDatagram(const char *data, int len, const QHostAddress &from, qint64 rxNs);
+    bool resumeSession(Client &c, const char *token, int len);
+    void parkSession(Client &c);
+    void playNote(Client &c, int instrument, int note, int velocity, qint64 rxNs,
+                  quint8 transport = JOURNAL_TEXT, quint32 seq = 0, quint64 clientTsUs = 0);
+    void logRecord(const BandEventRecord &rec, qint64 rxNs, const char *suffix);
+
+    struct TagHandler {
+        const char *name;   // 대문자
+        int         len;
+        void (NetServer::*fn)(Client &c, const char *payload, int len, qint64 rxNs);
+    };
+    static const TagHandler kTagTable[];
+    void postNote(int sampleId, int channel, float gain, qint64 rxNs, qint64 parseNs, qint64 playNs);
+
+    QTcpServer *server = nullptr;
+    QUdpSocket *m_udp = nullptr;
+    QTimer     *m_statsTimer = nullptr;
+    quint16     m_port = PORT;
+    QHash<QTcpSocket*, Client> clients;
+    QHash<quint32, QTcpSocket*> m_udpKeys;   // UDP key → 소유 연결 (보관 중인 세션이면 nullptr)
+    QHash<quint64, ParkedSession> m_sessions;   // 세션 토큰 → 끊긴 연결의 상태
+    QString m_lastStats;                     // 마지막으로 보낸 clientStatsSig 내용
+    QHash<QString, QString> idpw;
+    EventJournal m_journal;                  // 수락한 노트 이벤트 기록 (startServer ~ stopServer)
+
+    bool running = false;
+};
+
+#endif // NETSERVER_H
@@ -0,0 +1,29 @@
+#ifndef NOTEEVENT_H
+#define NOTEEVENT_H
+
+#include <chrono>
+#include <cstdint>
+
+// 단조 시계(ns). 수신/큐잉/렌더 시각을 모두 이 시계로 찍는다.
+static inline int64_t monoNowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 네트워크 쪽 → 오디오 엔진으로 넘기는 노트 이벤트 (40바이트)
+// rx/parse/queue 시각은 latencystats.h 의 구간 측정에 쓰인다.
+struct NoteEvent {
+    int64_t rxNs    = 0;   // readyRead 로 수신된 시각
+    int64_t parseNs = 0;   // 라인/레코드 파싱 완료 시각
+    int64_t queueNs = 0;   // 엔진 큐에 넣은 시각
+    int64_t playNs  = 0;   // 0 = 다음 블록 첫 프레임, 아니면 이 시각에 맞춰 샘플 단위로 예약 (퀀타이즈)
+    float   gain    = 1.f; // 0.0~1.0
+    uint8_t sample  = 0;   // SampleId
+    uint8_t channel = 0;   // 믹서 채널 (BandInstrument)
+    uint8_t reserved[2] = {0, 0};
+};
+
+static_assert(sizeof(NoteEvent) == 40, "NoteEvent must stay 40 bytes");
+
+#endif // NOTEEVENT_H
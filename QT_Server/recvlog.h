@@ -0,0 +1,48 @@
+#ifndef RECVLOG_H
+#define RECVLOG_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "spscring.h"
+
+// 수신 로그 링 (Qt 비의존).
+// 네트워크 스레드가 받은 줄을 고정 크기 레코드로 복사해 넣고, GUI 가 자기 주기에 맞춰 꺼내 간다.
+// 줄마다 QString/시그널을 만들지 않는다. 가득 차면 새 줄을 버리고 개수만 센다.
+struct RecvLogLine {
+    int64_t tsNs = 0;                 // 수신 시각 (monoNowNs)
+    uint16_t len = 0;
+    char     text[118];               // UTF-8, 넘치면 잘림 (NUL 종료 아님)
+};
+
+static_assert(sizeof(RecvLogLine) == 128, "RecvLogLine must be 128 bytes");
+
+class RecvLog
+{
+public:
+    static const size_t kCapacity = 4096;
+
+    // 생산자(네트워크 스레드) 전용
+    bool push(int64_t tsNs, const char *text, int len) {
+        RecvLogLine l;
+        l.tsNs = tsNs;
+        l.len  = uint16_t(std::max(0, std::min(len, int(sizeof(l.text)))));
+        std::memcpy(l.text, text, l.len);
+        if (m_ring.push(l)) return true;
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 소비자(GUI) 전용
+    bool pop(RecvLogLine &out) { return m_ring.pop(out); }
+
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing<RecvLogLine, kCapacity> m_ring;
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+#endif // RECVLOG_H
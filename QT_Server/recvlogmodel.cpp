@@ -0,0 +1,61 @@
+#include "recvlogmodel.h"
+#include "recvlog.h"
+
+RecvLogModel::RecvLogModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+    m_lines.resize(kMaxLines);
+}
+
+int RecvLogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant RecvLogModel::data(const QModelIndex &index, int role) const
+{
+    if (role != Qt::DisplayRole || !index.isValid() || index.row() >= m_count) return QVariant();
+    return m_lines[(m_head + index.row()) % kMaxLines];
+}
+
+int RecvLogModel::drain(RecvLog *log, int maxLines)
+{
+    if (!log) return 0;
+    QVector<QString> batch;
+    RecvLogLine l;
+    while (batch.size() < maxLines && log->pop(l))
+        batch.append(QString::fromUtf8(l.text, l.len));
+    if (!batch.isEmpty()) appendLines(batch);
+    return batch.size();
+}
+
+void RecvLogModel::appendLines(const QVector<QString> &lines)
+{
+    // 이번 배치만으로 넘치면 뒤쪽 kMaxLines 줄만 의미가 있다
+    const int skip = qMax(0, lines.size() - kMaxLines);
+    const int n = lines.size() - skip;
+    if (n <= 0) return;
+
+    const int overflow = qMax(0, m_count + n - kMaxLines);
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        m_head = (m_head + overflow) % kMaxLines;
+        m_count -= overflow;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), m_count, m_count + n - 1);
+    for (int i = 0; i < n; ++i)
+        m_lines[(m_head + m_count + i) % kMaxLines] = lines[skip + i];
+    m_count += n;
+    endInsertRows();
+}
+
+void RecvLogModel::clear()
+{
+    beginResetModel();
+    for (QString &s : m_lines) s.clear();
+    m_head = 0;
+    m_count = 0;
+    endResetModel();
+}
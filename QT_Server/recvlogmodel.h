@@ -0,0 +1,33 @@
+#ifndef RECVLOGMODEL_H
+#define RECVLOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+
+class RecvLog;
+
+// 크기가 고정된 원형 로그 모델. 가장 오래된 줄부터 밀려난다.
+// QListView(uniformItemSizes) 와 함께 쓰면 보이는 줄만 그리므로 줄 수와 무관하게 비용이 일정하다.
+class RecvLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    static const int kMaxLines = 5000;
+
+    explicit RecvLogModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+
+    // 링에 쌓인 줄을 한 번에 가져와 삽입 1회 + (넘친 만큼) 삭제 1회로 반영. 반환값: 가져온 줄 수
+    int drain(RecvLog *log, int maxLines);
+    void appendLines(const QVector<QString> &lines);
+    void clear();
+
+private:
+    QVector<QString> m_lines;   // kMaxLines 크기 원형 버퍼
+    int m_head  = 0;            // 가장 오래된 줄 위치
+    int m_count = 0;
+};
+
+#endif // RECVLOGMODEL_H
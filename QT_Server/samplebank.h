@@ -0,0 +1,110 @@
+#ifndef SAMPLEBANK_H
+#define SAMPLEBANK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// 패킹된 샘플 뱅크 파일 포맷 (Qt 비의존, header-only).
+// tools/mkbank 가 WAV 들을 엔진 출력 포맷(스테레오 interleaved int16, little-endian)으로
+// 미리 변환해 한 파일로 묶고, 서버는 이 파일을 mmap 해서 PCM 을 복사 없이 그대로 재생한다.
+//
+//   [SampleBankHeader][SampleBankEntry x count][패딩][PCM ...]
+//   각 PCM 블록은 kSampleBankAlign 바이트 경계에서 시작한다.
+
+static const char     kSampleBankMagic[8] = { 'B','A','N','D','S','M','P','1' };
+static const uint32_t kSampleBankVersion  = 1;
+static const uint32_t kSampleBankAlign    = 64;
+static const int      kSampleBankNameLen  = 24;
+
+#pragma pack(push, 1)
+struct SampleBankHeader {
+    char     magic[8];         // kSampleBankMagic
+    uint32_t version;          // kSampleBankVersion
+    uint32_t sampleRate;       // 엔진 출력 레이트와 같아야 함
+    uint32_t channels;         // 2 (스테레오 interleaved)
+    uint32_t count;            // 엔트리 수
+    uint64_t fileBytes;        // 잘린 파일 검출용
+};
+
+struct SampleBankEntry {
+    char     name[kSampleBankNameLen];   // 확장자 없는 WAV 파일명 ("PIANO_C", "kick" ...), NUL 패딩
+    uint64_t offset;                     // 파일 시작 기준 PCM 바이트 오프셋
+    uint32_t frames;                     // 스테레오 프레임 수
+    uint32_t reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SampleBankHeader) == 32, "SampleBankHeader must be 32 bytes");
+static_assert(sizeof(SampleBankEntry) == 40, "SampleBankEntry must be 40 bytes");
+
+static inline uint64_t sampleBankAlignUp(uint64_t v) {
+    return (v + kSampleBankAlign - 1) & ~uint64_t(kSampleBankAlign - 1);
+}
+
+// mmap 된 뱅크 읽기 뷰. base 가 살아 있는 동안만 유효.
+class SampleBankView
+{
+public:
+    bool open(const void *base, size_t size, std::string *err = nullptr)
+    {
+        m_base = static_cast<const unsigned char*>(base);
+        m_size = size;
+        m_hdr = nullptr;
+        if (!m_base || size < sizeof(SampleBankHeader)) return fail(err, "bank too small");
+
+        const SampleBankHeader *h = reinterpret_cast<const SampleBankHeader*>(m_base);
+        if (std::memcmp(h->magic, kSampleBankMagic, sizeof(h->magic)) != 0) return fail(err, "bad magic");
+        if (h->version != kSampleBankVersion) return fail(err, "unsupported version");
+        if (h->channels != 2) return fail(err, "bank is not stereo");
+        if (h->fileBytes != size) return fail(err, "size mismatch (truncated?)");
+        if (sizeof(SampleBankHeader) + uint64_t(h->count) * sizeof(SampleBankEntry) > size)
+            return fail(err, "index out of range");
+
+        // PCM 은 헤더/인덱스 뒤에서 시작해 파일 안에서 끝나야 한다 (offset + bytes 는 넘칠 수 있어 빼서 비교)
+        const uint64_t dataStart = sizeof(SampleBankHeader) + uint64_t(h->count) * sizeof(SampleBankEntry);
+        const SampleBankEntry *e = entries(h);
+        for (uint32_t i = 0; i < h->count; ++i) {
+            if (e[i].offset % 2 != 0 || e[i].offset < dataStart || e[i].offset > size
+                || uint64_t(e[i].frames) * 4 > size - e[i].offset)
+                return fail(err, "entry out of range");
+        }
+        m_hdr = h;
+        return true;
+    }
+
+    bool     isOpen() const     { return m_hdr != nullptr; }
+    uint32_t sampleRate() const { return m_hdr ? m_hdr->sampleRate : 0; }
+    uint32_t count() const      { return m_hdr ? m_hdr->count : 0; }
+
+    // 이름으로 찾기 (엔트리 수가 적어 선형 탐색). 없으면 -1
+    int find(const char *name) const
+    {
+        if (!m_hdr) return -1;
+        const SampleBankEntry *e = entries(m_hdr);
+        for (uint32_t i = 0; i < m_hdr->count; ++i)
+            if (std::strncmp(e[i].name, name, kSampleBankNameLen) == 0) return int(i);
+        return -1;
+    }
+
+    const int16_t *pcm(int idx) const {
+        return reinterpret_cast<const int16_t*>(m_base + entries(m_hdr)[idx].offset);
+    }
+    int frames(int idx) const { return int(entries(m_hdr)[idx].frames); }
+
+private:
+    static const SampleBankEntry *entries(const SampleBankHeader *h) {
+        return reinterpret_cast<const SampleBankEntry*>(h + 1);
+    }
+    static bool fail(std::string *err, const char *msg) {
+        if (err) *err = msg;
+        return false;
+    }
+
+    const unsigned char    *m_base = nullptr;
+    size_t                  m_size = 0;
+    const SampleBankHeader *m_hdr  = nullptr;
+};
+
+#endif // SAMPLEBANK_H
@@ -0,0 +1,52 @@
+#ifndef SAMPLEMAP_H
+#define SAMPLEMAP_H
+
+#include "band_protocol.h"
+
+// 악기/노트 → 엔진 샘플 슬롯, 속도/믹서 볼륨 → 게인 (Qt 비의존, header-only).
+// 라이브 서버(NetServer, AudioEngine, ServerCore)와 오프라인 렌더러(tools/render)가 같은 표를 쓴다.
+
+// 서버에서 쓰는 샘플 번호 (엔진 내부 샘플 슬롯과 1:1)
+enum SampleId {
+    SAMPLE_PIANO_C = 0, SAMPLE_PIANO_D, SAMPLE_PIANO_E, SAMPLE_PIANO_F,
+    SAMPLE_PIANO_G, SAMPLE_PIANO_A, SAMPLE_PIANO_B,
+    SAMPLE_GUITA_G, SAMPLE_GUITA_D, SAMPLE_GUITA_C,
+    SAMPLE_DRUM_TOM_HI, SAMPLE_DRUM_TOM_MID, SAMPLE_DRUM_CYMBAL_L,
+    SAMPLE_DRUM_KICK, SAMPLE_DRUM_CYMBAL_R,
+    SAMPLE_COUNT
+};
+
+// SampleId 순서와 동일해야 함 (샘플 뱅크 엔트리 이름 = WAV 파일명)
+static const char *const kSampleNames[SAMPLE_COUNT] = {
+    "PIANO_C", "PIANO_D", "PIANO_E", "PIANO_F",
+    "PIANO_G", "PIANO_A", "PIANO_B",
+    "G", "D", "C",
+    // Drum: tom_hi, tom_mid, cymbal_left, kick, cymbal_right
+    "tom_hi", "tom_mid", "cymbal_left", "kick", "cymbal_right"
+};
+
+// 악기별 첫 샘플 (BandInstrument 순서). 노트 번호는 그 뒤로 이어진다.
+static const int kSampleBase[BAND_INST_COUNT] = { SAMPLE_GUITA_G, SAMPLE_DRUM_TOM_HI, SAMPLE_PIANO_C };
+
+// 범위 밖이면 -1
+static inline int sampleForNote(int instrument, int note)
+{
+    if (instrument < 0 || instrument >= BAND_INST_COUNT) return -1;
+    if (note < 0 || note >= BAND_NOTE_COUNT[instrument]) return -1;
+    return kSampleBase[instrument] + note;
+}
+
+// 속도 0 = 속도 정보 없음 (텍스트 프로토콜) → 최대 음량
+static inline float velocityGain(int velocity)
+{
+    return (velocity > 0) ? float(velocity) / BAND_VELOCITY_MAX : 1.f;
+}
+
+// 믹서 슬라이더 0~100 → 채널 게인 0.0~1.0.
+// 사람 귀는 로그 스케일이라 약간의 감쇠를 줘도 됨. 일단 선형 매핑.
+static inline float mixerVolumeGain(int volume)
+{
+    return (volume < 0 ? 0 : (volume > 100 ? 100 : volume)) / 100.0f;
+}
+
+#endif // SAMPLEMAP_H
@@ -0,0 +1,75 @@
+#ifndef SEQWINDOW_H
+#define SEQWINDOW_H
+
+#include <cstdint>
+
+// UDP 이벤트 순번 창 (클라이언트별).
+// 가장 큰 seq 와 그 아래 64개 수신 여부 비트맵으로 중복/역순/손실을 판정한다.
+//  - 새 seq (> highest)          : 수락, 사이 빈 번호는 일단 손실로 계산
+//  - 이미 받은 seq               : 중복 → 버림
+//  - 안 받은 이전 seq (역순 도착) : 손실에서 빼고, 마감 시간 안이면 수락 / 넘었으면 버림
+class SeqWindow
+{
+public:
+    enum Verdict { Accept, AcceptReordered, Duplicate, Late };
+
+    struct Stats {
+        uint64_t received   = 0;   // 도착한 데이터그램
+        uint64_t accepted   = 0;
+        uint64_t duplicates = 0;
+        uint64_t reordered  = 0;   // 역순 도착했지만 마감 안이라 수락
+        uint64_t late       = 0;   // 역순 + 마감 초과(또는 창 밖) → 버림
+        uint64_t lost       = 0;   // 아직 도착하지 않은 번호 수 (추정)
+    };
+
+    // clientTsUs: 이벤트의 클라이언트 시각, deadlineUs: 허용 지연
+    Verdict offer(uint32_t seq, uint64_t clientTsUs, uint64_t deadlineUs)
+    {
+        ++m_stats.received;
+        if (!m_started) {
+            m_started = true;
+            m_highest = seq;
+            m_highestTs = clientTsUs;
+            m_bits = 1;
+            ++m_stats.accepted;
+            return Accept;
+        }
+
+        if (int32_t(seq - m_highest) > 0) {
+            const uint32_t shift = seq - m_highest;
+            m_stats.lost += shift - 1;
+            m_bits = (shift >= 64) ? 1 : ((m_bits << shift) | 1);
+            m_highest = seq;
+            m_highestTs = clientTsUs;
+            ++m_stats.accepted;
+            return Accept;
+        }
+
+        const uint32_t back = m_highest - seq;
+        if (back >= 64) { ++m_stats.late; return Late; }     // 창 밖: 판정 불가 → 늦은 것으로 처리
+
+        const uint64_t bit = uint64_t(1) << back;
+        if (m_bits & bit) { ++m_stats.duplicates; return Duplicate; }
+
+        m_bits |= bit;
+        if (m_stats.lost > 0) --m_stats.lost;
+        if (m_highestTs > clientTsUs && m_highestTs - clientTsUs > deadlineUs) {
+            ++m_stats.late;
+            return Late;
+        }
+        ++m_stats.reordered;
+        ++m_stats.accepted;
+        return AcceptReordered;
+    }
+
+    const Stats &stats() const { return m_stats; }
+
+private:
+    bool     m_started = false;
+    uint32_t m_highest = 0;
+    uint64_t m_highestTs = 0;
+    uint64_t m_bits = 0;       // bit k = (highest - k) 수신 여부
+    Stats    m_stats;
+};
+
+#endif // SEQWINDOW_H
@@ -0,0 +1,58 @@
+# 서버 코어: 소켓/파싱(NetServer), 오디오 엔진(AudioEngine/MixerCore), 저널, 비동기 로그, ServerCore.
+# 위젯 없이 QtCore/QtNetwork/QtMultimedia 만 쓴다.
+# 위젯 앱(QT_Server.pro)과 헤드리스 실행 파일(headless/headless.pro)이 include 해서 같은 소스를 빌드한다.
+
+QT += core network multimedia
+
+CONFIG += c++11
+
+# 서버/클라이언트 공용 프로토콜 헤더 (common/band_protocol.h)
+INCLUDEPATH += $$PWD $$PWD/../common
+
+# 비동기 로그(serverlog.h) 컴파일 타임 최저 레벨: release 에서는 trace/debug 호출을 아예 빼버림
+CONFIG(release, debug|release): DEFINES += SERVER_LOG_COMPILE_LEVEL=LOGLV_INFO
+
+SOURCES += \
+    $$PWD/audioengine.cpp \
+    $$PWD/eventjournal.cpp \
+    $$PWD/mixercore.cpp \
+    $$PWD/netserver.cpp \
+    $$PWD/servercore.cpp \
+    $$PWD/serverlog.cpp \
+    $$PWD/wavdecoder.cpp
+
+HEADERS += \
+    $$PWD/../common/band_protocol.h \
+    $$PWD/audioengine.h \
+    $$PWD/cmdparser.h \
+    $$PWD/eventjournal.h \
+    $$PWD/jitterbuffer.h \
+    $$PWD/journalformat.h \
+    $$PWD/latencystats.h \
+    $$PWD/mixercore.h \
+    $$PWD/mpscring.h \
+    $$PWD/netserver.h \
+    $$PWD/noteevent.h \
+    $$PWD/recvlog.h \
+    $$PWD/samplebank.h \
+    $$PWD/samplemap.h \
+    $$PWD/seqwindow.h \
+    $$PWD/servercore.h \
+    $$PWD/serverlog.h \
+    $$PWD/spscring.h \
+    $$PWD/tempogrid.h \
+    $$PWD/wavdecoder.h
+
+# 로그인 ID/PW 파일 (idpasswd.txt)
+RESOURCES += \
+    $$PWD/wav.qrc
+
+# 악기 WAV 를 실행 파일에 넣기 (기본 꺼짐, 약 7 MB). qmake CONFIG+=embed_wav
+# 켜면 샘플 뱅크/WAV 폴더에 없는 샘플을 :/samples/<이름>.wav 에서 디코딩한다.
+embed_wav {
+    DEFINES += QT_SERVER_EMBED_WAV
+    RESOURCES += $$PWD/samples_wav.qrc
+}
+
+# 뱅크에 없는 샘플의 WAV 폴백: 설치 시 실행 파일 옆 samples/ 에 복사
+SAMPLE_WAVS = $$files($$PWD/*.wav)
@@ -0,0 +1,132 @@
+#include "servercore.h"
+#include <QDebug>
+#include <QSettings>
+
+static const char *const kTempoInstKeys[BAND_INST_COUNT] = { "guita", "drum", "piano" };
+
+ServerCore::ServerCore(const ServerConfig &cfg, QObject *parent)
+: QObject{parent}
+{
+    // 오디오 엔진: 15개 샘플을 미리 PCM 으로 디코딩하고 출력 스트림 1개만 연다.
+    // 렌더링(readData)은 전용 스레드에서 돌고, 소켓 쪽은 post() 로 큐에 넣기만 한다.
+    m_engine = new AudioEngine;
+    if (!m_engine->loadSamples())
+        qCritical() << "[SERVER] instrument samples missing - build samples.bank with tools/mkbank, install samples/ or set QT_SERVER_WAV_DIR";
+    if (!cfg.audio.isEmpty() && !m_engine->setSink(cfg.audio))
+        qWarning() << "[SERVER] unknown audio sink" << cfg.audio << "-> device";
+    m_engine->moveToThread(&m_audioThread);
+    connect(&m_audioThread, &QThread::finished, m_engine, &QObject::deleteLater);
+    m_audioThread.setObjectName(QStringLiteral("audio"));
+    m_audioThread.start(QThread::TimeCriticalPriority);
+    QMetaObject::invokeMethod(m_engine, "start", Qt::QueuedConnection);
+
+    loadTempoSettings();
+    loadJitterSettings();
+
+    // 소켓 계층: 기본은 전용 네트워크 스레드
+    m_netThreaded = qgetenv("QT_SERVER_NET_INLINE") != "1";
+    m_net = new NetServer(m_engine, cfg.recvLog ? &m_recvLog : nullptr, &m_tempo, &m_jitter);
+    m_net->setPort(cfg.port);
+    if (m_netThreaded) {
+        m_net->moveToThread(&m_netThread);
+        connect(&m_netThread, &QThread::finished, m_net, &QObject::deleteLater);
+        m_netThread.setObjectName(QStringLiteral("net"));
+        m_netThread.start(QThread::HighPriority);
+    } else {
+        m_net->setParent(this);
+    }
+
+    // 클라이언트 통계 → UI (스레드 모드에서는 자동으로 queued). 수신 줄은 m_recvLog 링으로 전달
+    connect(m_net, &NetServer::clientStatsSig, this, &ServerCore::clientStatsSig);
+    qInfo() << "[SERVER] network layer on" << (m_netThreaded ? "dedicated thread" : "main thread");
+}
+
+
+ServerCore::~ServerCore() {
+    stopServer();
+    if (m_netThreaded) {
+        m_netThread.quit();
+        m_netThread.wait();
+    }
+    QMetaObject::invokeMethod(m_engine, "stop", Qt::BlockingQueuedConnection);
+    m_audioThread.quit();
+    m_audioThread.wait();
+}
+
+bool ServerCore::startServer()
+{
+    bool ok = false;
+    QMetaObject::invokeMethod(m_net, "startServer",
+                              m_netThreaded ? Qt::BlockingQueuedConnection : Qt::DirectConnection,
+                              Q_RETURN_ARG(bool, ok));
+    return ok;
+}
+
+void ServerCore::stopServer()
+{
+    QMetaObject::invokeMethod(m_net, "stopServer",
+                              m_netThreaded ? Qt::BlockingQueuedConnection : Qt::DirectConnection);
+}
+
+void ServerCore::onMixerVolume(int channel, int volume)
+{
+    // 엔진 채널 게인 0.0~1.0 (매핑은 오프라인 렌더러와 공유: samplemap.h)
+    m_engine->setChannelGain(channel, mixerVolumeGain(volume));
+}
+
+void ServerCore::onMixerMute(int channel, bool mute)
+{
+    m_engine->setChannelMute(channel, mute);
+    qInfo() << "[MIXER] mute ch" << channel << "->" << (mute ? "on" : "off");
+}
+
+void ServerCore::loadTempoSettings()
+{
+    QSettings st(QStringLiteral("RemoteBand"), QStringLiteral("QT_Server"));
+    st.beginGroup(QStringLiteral("tempo"));
+    m_tempo.setBpm(st.value(QStringLiteral("bpm"), m_tempo.bpm()).toInt());
+    m_tempo.setSubdiv(st.value(QStringLiteral("subdiv"), m_tempo.subdiv()).toInt());
+    for (int i = 0; i < BAND_INST_COUNT; ++i) {
+        const QString k = QString::fromLatin1(kTempoInstKeys[i]);
+        m_tempo.setWindowMs(i, st.value(k + QStringLiteral("/windowMs"), m_tempo.windowMs(i)).toInt());
+        m_tempo.setStrength(i, st.value(k + QStringLiteral("/strength"), m_tempo.strength(i)).toInt());
+    }
+    m_tempo.setEnabled(st.value(QStringLiteral("enabled"), false).toBool());
+    st.endGroup();
+}
+
+void ServerCore::saveTempoSettings()
+{
+    QSettings st(QStringLiteral("RemoteBand"), QStringLiteral("QT_Server"));
+    st.beginGroup(QStringLiteral("tempo"));
+    st.setValue(QStringLiteral("enabled"), m_tempo.enabled());
+    st.setValue(QStringLiteral("bpm"), m_tempo.bpm());
+    st.setValue(QStringLiteral("subdiv"), m_tempo.subdiv());
+    for (int i = 0; i < BAND_INST_COUNT; ++i) {
+        const QString k = QString::fromLatin1(kTempoInstKeys[i]);
+        st.setValue(k + QStringLiteral("/windowMs"), m_tempo.windowMs(i));
+        st.setValue(k + QStringLiteral("/strength"), m_tempo.strength(i));
+    }
+    st.endGroup();
+}
+
+void ServerCore::loadJitterSettings()
+{
+    QSettings st(QStringLiteral("RemoteBand"), QStringLiteral("QT_Server"));
+    st.beginGroup(QStringLiteral("jitter"));
+    m_jitter.percentile = qBound(50, st.value(QStringLiteral("percentile"), m_jitter.percentile.load()).toInt(), 100);
+    m_jitter.maxDelayMs = qBound(0, st.value(QStringLiteral("maxDelayMs"), m_jitter.maxDelayMs.load()).toInt(),
+                                 int(JitterConfig::kMaxDelayMs));
+    m_jitter.enabled = st.value(QStringLiteral("enabled"), false).toBool();
+    st.endGroup();
+}
+
+void ServerCore::saveJitterSettings()
+{
+    QSettings st(QStringLiteral("RemoteBand"), QStringLiteral("QT_Server"));
+    st.beginGroup(QStringLiteral("jitter"));
+    st.setValue(QStringLiteral("enabled"), m_jitter.enabled.load());
+    st.setValue(QStringLiteral("percentile"), m_jitter.percentile.load());
+    st.setValue(QStringLiteral("maxDelayMs"), m_jitter.maxDelayMs.load());
+    st.endGroup();
+}
@@ -0,0 +1,69 @@
+#ifndef SERVERCORE_H
+#define SERVERCORE_H
+
+#include <QObject>
+#include <QThread>
+
+#include "audioengine.h"
+#include "netserver.h"
+#include "jitterbuffer.h"
+#include "recvlog.h"
+#include "tempogrid.h"
+
+// 서버 코어 구성 (위젯 앱은 기본값, 헤드리스 실행 파일은 명령행에서 채운다)
+struct ServerConfig {
+    quint16 port = PORT;
+    QString audio;          // "device" | "null" | "wav:<path>", 비어 있으면 $QT_SERVER_AUDIO (없으면 device)
+    bool    recvLog = true; // 수신 줄을 RecvLog 링에 남길지 (소비할 UI 가 없으면 false)
+};
+
+// 서버 구성요소(오디오 엔진, 소켓 계층)를 각자의 스레드에 띄우는 위젯 비의존 코어.
+//  - m_audioThread : AudioEngine (pull 콜백 렌더링 또는 null/wav 싱크)
+//  - m_netThread   : NetServer   (QTcpServer/readyRead/파싱)
+// 공유 템포 그리드(퀀타이즈 설정)와 지터 버퍼 설정도 여기서 들고 QSettings 로 저장/복원한다.
+// 위젯 앱(Tab1Socketserver)과 헤드리스 실행 파일(headless/)이 같은 코어를 쓴다 (server_core.pri).
+// QT_SERVER_NET_INLINE=1 이면 NetServer 를 예전처럼 메인 스레드에서 돌린다 (비교/디버깅용).
+class ServerCore : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ServerCore(const ServerConfig &cfg = ServerConfig(), QObject *parent = nullptr);
+    ~ServerCore() override;
+
+    bool isNetThreaded() const { return m_netThreaded; }
+    AudioEngine *engine() const { return m_engine; }
+    RecvLog *recvLog() { return &m_recvLog; }   // 소비자(pop)는 GUI 스레드 하나
+    TempoGrid *tempo() { return &m_tempo; }
+    JitterConfig *jitter() { return &m_jitter; }
+
+public slots:
+    bool startServer();
+    void stopServer();
+
+    // ★ Mixer 연동 (channel = BandInstrument). 엔진 채널 원자값에 바로 기록 → 오디오 스레드가 램프 적용
+    void onMixerVolume(int channel, int volume); // 0~100
+    void onMixerMute(int channel, bool mute);
+
+    // 템포/퀀타이즈 설정 저장 (TempoWidget 에서 값이 바뀔 때)
+    void saveTempoSettings();
+    // 지터 버퍼 설정 저장 (Tab1 에서 값이 바뀔 때)
+    void saveJitterSettings();
+
+signals:
+    void clientStatsSig(const QString &text);
+
+private:
+    void loadTempoSettings();
+    void loadJitterSettings();
+
+    RecvLog      m_recvLog;             // 네트워크 스레드 → 수신 로그 뷰
+    TempoGrid    m_tempo;               // GUI 가 설정, 네트워크 스레드가 이벤트마다 읽음
+    JitterConfig m_jitter;              // 〃 (클라이언트별 추정 상태는 NetServer::Client 안)
+    AudioEngine *m_engine = nullptr;    // 단일 출력 스트림 + 보이스 풀 (m_audioThread 소속)
+    QThread      m_audioThread;
+    NetServer   *m_net = nullptr;       // 소켓 계층 (m_netThread 소속)
+    QThread      m_netThread;
+    bool         m_netThreaded = true;
+};
+
+#endif // SERVERCORE_H
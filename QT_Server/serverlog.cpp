@@ -0,0 +1,130 @@
+#include "serverlog.h"
+#include "mpscring.h"
+#include "noteevent.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <thread>
+
+std::atomic<int> ServerLog::s_level{LOGLV_OFF};
+
+namespace {
+
+const char *const kLevelNames[LOGLV_OFF + 1] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "OFF" };
+
+MpscRing<LogRecord, ServerLog::kCapacity> g_ring;
+std::atomic<uint64_t> g_dropped{0};
+std::atomic<uint64_t> g_written{0};
+std::atomic<bool>     g_running{false};
+std::thread           g_thread;
+FILE                 *g_out = nullptr;
+int64_t               g_startNs = 0;
+
+int parseLevel(const char *s, int def)
+{
+    if (!s || !*s) return def;
+    for (int i = 0; i <= LOGLV_OFF; ++i)
+        if (strcasecmp(s, kLevelNames[i]) == 0) return i;
+    if (s[0] >= '0' && s[0] <= '5' && s[1] == '\0') return s[0] - '0';
+    std::fprintf(stderr, "[LOG] unknown QT_SERVER_LOG_LEVEL '%s' -> %s\n", s, kLevelNames[def]);
+    return def;
+}
+
+void format(const LogRecord &r)
+{
+    char line[256];
+    int n = std::snprintf(line, sizeof(line), "%12.6f %-5s %s",
+                          double(r.tsNs - g_startNs) / 1e9, kLevelNames[r.level], r.event);
+    if (r.textLen > 0 && n < int(sizeof(line)))
+        n += std::snprintf(line + n, sizeof(line) - n, " '%.*s'", int(r.textLen), r.text);
+    for (int i = 0; i < r.nkv && n < int(sizeof(line)); ++i)
+        n += std::snprintf(line + n, sizeof(line) - n, " %s=%lld", r.kv[i].key, (long long)r.kv[i].val);
+    std::fprintf(g_out, "%s\n", line);
+}
+
+// 링에 있는 만큼 쓰고 한 번만 flush
+int drain()
+{
+    LogRecord r;
+    int n = 0;
+    while (g_ring.pop(r)) {
+        format(r);
+        ++n;
+    }
+    if (n > 0) {
+        std::fflush(g_out);
+        g_written.fetch_add(uint64_t(n), std::memory_order_relaxed);
+    }
+    return n;
+}
+
+void run()
+{
+    while (g_running.load(std::memory_order_acquire)) {
+        if (drain() == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(ServerLog::kIdleMs));
+    }
+    drain();
+}
+
+} // namespace
+
+void ServerLog::start()
+{
+    if (g_running.load()) return;
+
+    g_out = stderr;
+    if (const char *path = std::getenv("QT_SERVER_LOG_FILE")) {
+        if (FILE *f = std::fopen(path, "a")) g_out = f;
+        else std::fprintf(stderr, "[LOG] cannot open %s -> stderr\n", path);
+    }
+    g_startNs = monoNowNs();
+    g_running.store(true, std::memory_order_release);
+    g_thread = std::thread(run);
+    setLevel(parseLevel(std::getenv("QT_SERVER_LOG_LEVEL"), LOGLV_INFO));
+}
+
+void ServerLog::stop()
+{
+    if (!g_running.load()) return;
+
+    setLevel(LOGLV_OFF);
+    g_running.store(false, std::memory_order_release);
+    g_thread.join();
+
+    const uint64_t lost = dropped();
+    if (lost > 0) std::fprintf(g_out, "[LOG] %llu records dropped (ring full)\n", (unsigned long long)lost);
+    std::fflush(g_out);
+    if (g_out != stderr) std::fclose(g_out);
+    g_out = nullptr;
+}
+
+void ServerLog::write(int level, const char *event, const char *text, int textLen,
+                      std::initializer_list<LogKV> kv)
+{
+    LogRecord r;
+    r.tsNs    = monoNowNs();
+    r.event   = event;
+    r.level   = uint8_t(level);
+    r.nkv     = uint8_t(std::min<size_t>(kv.size(), LogRecord::kMaxKv));
+    std::copy(kv.begin(), kv.begin() + r.nkv, r.kv);
+    r.textLen = uint8_t(text ? std::max(0, std::min(textLen, LogRecord::kTextLen)) : 0);
+    if (r.textLen) std::memcpy(r.text, text, r.textLen);
+
+    if (!g_ring.push(r))
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t ServerLog::dropped()
+{
+    return g_dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t ServerLog::written()
+{
+    return g_written.load(std::memory_order_relaxed);
+}
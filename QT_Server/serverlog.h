@@ -0,0 +1,93 @@
+#ifndef SERVERLOG_H
+#define SERVERLOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+// 서버 핫패스용 비동기 구조화 로그 (Qt 비의존).
+// 호출 스레드는 고정 크기 레코드(이벤트 이름 + 짧은 텍스트 + 정수 key=value 최대 3개)를
+// lock-free 링에 넣기만 하고, 문자열 포맷/출력은 백그라운드 스레드가 한다.
+// 링이 가득 차면 레코드를 버리고 개수만 센다 (dropped).
+//
+//   SLOG_DEBUG("parse", cmd.tag, cmd.tagLen, {{"len", cmd.payloadLen}});
+//
+// 레벨 검사는 두 단계:
+//   컴파일 타임: SERVER_LOG_COMPILE_LEVEL 미만인 호출은 통째로 사라진다 (.pro 에서 지정)
+//   런타임    : QT_SERVER_LOG_LEVEL (trace/debug/info/warn/error/off, 기본 info)
+// 꺼진 레벨은 인자 평가 없이 분기 하나로 끝난다.
+// 출력: QT_SERVER_LOG_FILE 이 있으면 그 파일에 추가, 없으면 stderr.
+// 이벤트 이름/키는 문자열 리터럴(정적 수명)이어야 한다 — 포인터만 복사한다.
+
+enum LogLevel {
+    LOGLV_TRACE = 0,
+    LOGLV_DEBUG,
+    LOGLV_INFO,
+    LOGLV_WARN,
+    LOGLV_ERROR,
+    LOGLV_OFF
+};
+
+#ifndef SERVER_LOG_COMPILE_LEVEL
+#define SERVER_LOG_COMPILE_LEVEL LOGLV_TRACE
+#endif
+
+struct LogKV {
+    const char *key;
+    int64_t     val;
+};
+
+// 링에 들어가는 레코드 1건 (포맷 전 원본)
+struct LogRecord {
+    static const int kMaxKv   = 3;
+    static const int kTextLen = 46;
+
+    int64_t     tsNs;
+    const char *event;
+    LogKV       kv[kMaxKv];
+    uint8_t     level;
+    uint8_t     nkv;
+    uint8_t     textLen;
+    char        text[kTextLen];   // NUL 종료 아님, 넘치면 잘림
+};
+
+class ServerLog
+{
+public:
+    static const size_t kCapacity = 8192;
+    static const int    kIdleMs   = 5;      // 링이 비었을 때 포맷 스레드 대기
+
+    // 환경변수로 레벨/출력을 정하고 포맷 스레드 시작. 시작 전에는 모든 레벨이 꺼져 있다.
+    static void start();
+    // 남은 레코드를 모두 쓰고 스레드 종료
+    static void stop();
+
+    static bool enabled(int level) { return level >= s_level.load(std::memory_order_relaxed); }
+    static void setLevel(int level) { s_level.store(level, std::memory_order_relaxed); }
+    static int  level() { return s_level.load(std::memory_order_relaxed); }
+
+    // 아무 스레드에서나 호출 가능. 보통은 아래 SLOG_* 매크로로 부른다.
+    static void write(int level, const char *event, const char *text = nullptr, int textLen = 0,
+                      std::initializer_list<LogKV> kv = {});
+
+    static uint64_t dropped();   // 링이 가득 차서 버린 레코드 수
+    static uint64_t written();   // 포맷 스레드가 출력한 레코드 수
+
+private:
+    static std::atomic<int> s_level;
+};
+
+#define SLOG(lvl, ...)                                                              \
+    do {                                                                            \
+        if ((lvl) >= SERVER_LOG_COMPILE_LEVEL && ServerLog::enabled(lvl))           \
+            ServerLog::write((lvl), __VA_ARGS__);                                   \
+    } while (0)
+
+#define SLOG_TRACE(...) SLOG(LOGLV_TRACE, __VA_ARGS__)
+#define SLOG_DEBUG(...) SLOG(LOGLV_DEBUG, __VA_ARGS__)
+#define SLOG_INFO(...)  SLOG(LOGLV_INFO,  __VA_ARGS__)
+#define SLOG_WARN(...)  SLOG(LOGLV_WARN,  __VA_ARGS__)
+#define SLOG_ERROR(...) SLOG(LOGLV_ERROR, __VA_ARGS__)
+
+#endif // SERVERLOG_H
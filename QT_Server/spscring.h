@@ -0,0 +1,45 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+
+// 단일 생산자/단일 소비자 lock-free 링 버퍼.
+// N 은 2의 거듭제곱. push 는 생산자 스레드에서만, pop 은 소비자 스레드에서만 호출한다.
+template <typename T, size_t N>
+class SpscRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+public:
+    bool push(const T &v) {
+        const size_t h = m_head.load(std::memory_order_relaxed);
+        if (h - m_tail.load(std::memory_order_acquire) >= N) return false;   // 가득 참
+        m_buf[h & (N - 1)] = v;
+        m_head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &out) {
+        const size_t t = m_tail.load(std::memory_order_relaxed);
+        if (t == m_head.load(std::memory_order_acquire)) return false;       // 비어 있음
+        out = m_buf[t & (N - 1)];
+        m_tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 어느 스레드에서든 호출 가능 (근사값)
+    size_t size() const {
+        const size_t t = m_tail.load(std::memory_order_acquire);
+        const size_t h = m_head.load(std::memory_order_acquire);
+        return h - t;
+    }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T m_buf[N];
+    // head/tail 을 다른 캐시 라인에 두어 false sharing 방지
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+};
+
+#endif // SPSCRING_H
@@ -1,13 +1,29 @@
 #include "tab1socketserver.h"
 #include "ui_tab1socketserver.h"
+#include <QScrollBar>
 
 Tab1Socketserver::Tab1Socketserver(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::Tab1Socketserver)
 {
     ui->setupUi(this);
-    pServerWidget = new ServerWidget(this);
-    connect(pServerWidget, &ServerWidget::socketRecvDataSig, this, &Tab1Socketserver::updateRecvDataSlot);
+    pServerCore = new ServerCore(ServerConfig(), this);
+
+    // 수신 로그: 원형 모델 + 가상화된 리스트 뷰, 고정 주기로 링에서 일괄 반영
+    m_logModel = new RecvLogModel(this);
+    ui->pLVrecvData->setModel(m_logModel);
+    connect(&m_logTimer, &QTimer::timeout, this, &Tab1Socketserver::updateRecvDataSlot);
+    connect(pServerCore, &ServerCore::clientStatsSig, this, &Tab1Socketserver::updateClientStatsSlot);
+
+    // 지터 버퍼: 설정 원자값에 바로 쓰고 저장. 통계는 클라이언트 줄(pLClientStats)에 붙어 나온다
+    JitterConfig *jc = pServerCore->jitter();
+    ui->pCBJitter->setChecked(jc->enabled);
+    ui->pSBJitterPct->setValue(jc->percentile);
+    ui->pSBJitterMax->setMaximum(JitterConfig::kMaxDelayMs);
+    ui->pSBJitterMax->setValue(jc->maxDelayMs);
+    connect(ui->pCBJitter, &QCheckBox::toggled, this, &Tab1Socketserver::onJitterEdited);
+    connect(ui->pSBJitterPct, QOverload<int>::of(&QSpinBox::valueChanged), this, &Tab1Socketserver::onJitterEdited);
+    connect(ui->pSBJitterMax, QOverload<int>::of(&QSpinBox::valueChanged), this, &Tab1Socketserver::onJitterEdited);
 }
 
 Tab1Socketserver::~Tab1Socketserver()
@@ -17,16 +33,59 @@ Tab1Socketserver::~Tab1Socketserver()
 
 void Tab1Socketserver::on_pStart_clicked()
 {
-    pServerWidget->startServer();
+    pServerCore->startServer();
 }
 
 void Tab1Socketserver::on_pStop_clicked()
 {
-    pServerWidget->stopServer();
+    pServerCore->stopServer();
+}
+
+void Tab1Socketserver::showEvent(QShowEvent *e)
+{
+    QWidget::showEvent(e);
+    updateRecvDataSlot();
+    m_logTimer.start(kLogRefreshMs);
+}
+
+void Tab1Socketserver::hideEvent(QHideEvent *e)
+{
+    // 안 보이는 동안은 아무것도 하지 않는다. 링이 차면 네트워크 스레드가 새 줄을 버리고 개수만 센다
+    m_logTimer.stop();
+    QWidget::hideEvent(e);
+}
+
+void Tab1Socketserver::updateRecvDataSlot()
+{
+    RecvLog *log = pServerCore->recvLog();
+    QScrollBar *sb = ui->pLVrecvData->verticalScrollBar();
+    const bool atBottom = sb->value() >= sb->maximum();
+
+    int added = 0;
+    const quint64 dropped = log->dropped();
+    if (dropped != m_logDropped) {
+        // 먼저 링에 남은(오래된) 줄을 넣고, 그 뒤에 빠진 줄 수를 표시
+        added += m_logModel->drain(log, int(RecvLog::kCapacity));
+        m_logModel->appendLines({ tr("... %1 lines not shown (log buffer full)").arg(dropped - m_logDropped) });
+        m_logDropped = dropped;
+        ++added;
+    }
+    added += m_logModel->drain(log, int(RecvLog::kCapacity));
+    if (added > 0 && atBottom)
+        ui->pLVrecvData->scrollToBottom();   // 사용자가 위로 스크롤해 보고 있으면 따라가지 않음
+}
+
+// 클라이언트별 seq 카운터 (UDP 손실/역순/늦음/중복, TCP 바이너리 gap) + 지터/재생 지연
+void Tab1Socketserver::updateClientStatsSlot(const QString &text)
+{
+    ui->pLClientStats->setText(text);
 }
 
-void Tab1Socketserver::updateRecvDataSlot(QString strRecvData)
+void Tab1Socketserver::onJitterEdited()
 {
-   strRecvData.chop(1);   //끝문자 한개 "\n" 제거
-   ui->pTErecvData->append(strRecvData);
+    JitterConfig *jc = pServerCore->jitter();
+    jc->percentile = ui->pSBJitterPct->value();
+    jc->maxDelayMs = ui->pSBJitterMax->value();
+    jc->enabled    = ui->pCBJitter->isChecked();
+    pServerCore->saveJitterSettings();
 }
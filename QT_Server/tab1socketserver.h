@@ -2,7 +2,9 @@
 #define TAB1SOCKETSERVER_H
 
 #include <QWidget>
-#include "serverwidget.h"
+#include <QTimer>
+#include "servercore.h"
+#include "recvlogmodel.h"
 
 namespace Ui {
 class Tab1Socketserver;
@@ -13,22 +15,33 @@ class Tab1Socketserver : public QWidget
     Q_OBJECT
 
 public:
+    static const int kLogRefreshMs = 100;   // 수신 로그 링 → 모델 반영 주기
+
     explicit Tab1Socketserver(QWidget *parent = nullptr);
     ~Tab1Socketserver();
-    inline ServerWidget* serverWidget() const { return pServerWidget; }
+    inline ServerCore* serverCore() const { return pServerCore; }
 
 signals:
     void socketRecvDataSig(QString strRecvData);
 
+protected:
+    void showEvent(QShowEvent *e) override;
+    void hideEvent(QHideEvent *e) override;
+
 private slots:
 
     void on_pStart_clicked();
-    void updateRecvDataSlot(QString);
+    void updateRecvDataSlot();
+    void updateClientStatsSlot(const QString &text);
+    void onJitterEdited();
     void on_pStop_clicked();
 
 private:
     Ui::Tab1Socketserver *ui;
-    ServerWidget *pServerWidget;
+    ServerCore *pServerCore;
+    RecvLogModel *m_logModel = nullptr;
+    QTimer        m_logTimer;           // 탭이 보일 때만 동작
+    quint64       m_logDropped = 0;     // 마지막으로 표시한 링 드롭 수
 };
 
 #endif // TAB1SOCKETSERVER_H
@@ -0,0 +1,115 @@
+#ifndef TEMPOGRID_H
+#define TEMPOGRID_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+#include "band_protocol.h"
+#include "noteevent.h"
+
+// 공유 템포 그리드 + 악기별 퀀타이즈 (Qt 비의존).
+// 설정은 GUI 가 원자값으로 쓰고, 네트워크 스레드가 이벤트마다 schedule() 로 재생 시각을 정한다.
+//
+//   grid   : origin + k * (60 s / bpm / subdiv)
+//   d      : 수신 시각 → 가장 가까운 그리드 선까지 (음수 = 앞으로 당김)
+//   |d| <= window[악기] 이면 d * strength% 만큼 옮기고, 밖이면 그대로 둔다.
+//   앞으로 당길 수 있도록 모든 이벤트를 lookahead(= 켜진 악기 중 최대 window) 만큼 늦춰 예약한다.
+//   악기 사이 상대 타이밍이 유지되도록 lookahead 는 모든 악기에 같은 값.
+class TempoGrid
+{
+public:
+    static const int kMinBpm      = 40;
+    static const int kMaxBpm      = 240;
+    static const int kMaxWindowMs = 120;
+
+    // 이동량 통계 (네트워크 스레드가 쓰고 GUI 가 읽음)
+    struct Stats {
+        std::atomic<uint64_t> events{0};      // 퀀타이즈 켜진 동안 들어온 이벤트
+        std::atomic<uint64_t> moved{0};       // window 안이라 옮긴 이벤트
+        std::atomic<uint64_t> outside{0};     // window 밖이라 그대로 둔 이벤트
+        std::atomic<uint64_t> sumAbsUs{0};    // 옮긴 양 |shift| 합
+        std::atomic<uint32_t> maxAbsUs{0};
+        std::atomic<int32_t>  lastUs{0};      // 마지막 이벤트 이동량 (부호 포함)
+    };
+
+    TempoGrid() {
+        for (int i = 0; i < BAND_INST_COUNT; ++i) { m_windowMs[i] = 30; m_strength[i] = 100; }
+    }
+
+    void setEnabled(bool on) { if (on && !m_enabled) resetOrigin(); m_enabled = on; }
+    bool enabled() const { return m_enabled; }
+
+    void setBpm(int bpm) { m_bpm = bpm < kMinBpm ? kMinBpm : (bpm > kMaxBpm ? kMaxBpm : bpm); resetOrigin(); }
+    int  bpm() const { return m_bpm; }
+    // 한 박을 몇 칸으로 나눌지 (1=4분, 2=8분, 3=8분 셋잇단, 4=16분)
+    void setSubdiv(int n) { m_subdiv = n < 1 ? 1 : (n > 8 ? 8 : n); }
+    int  subdiv() const { return m_subdiv; }
+
+    void setWindowMs(int inst, int ms) { m_windowMs[inst] = ms < 0 ? 0 : (ms > kMaxWindowMs ? kMaxWindowMs : ms); }
+    int  windowMs(int inst) const { return m_windowMs[inst]; }
+    void setStrength(int inst, int pct) { m_strength[inst] = pct < 0 ? 0 : (pct > 100 ? 100 : pct); }
+    int  strength(int inst) const { return m_strength[inst]; }
+
+    // 그리드 기준점을 지금으로 (bpm 변경/켜기 때)
+    void resetOrigin() { m_originNs = monoNowNs(); }
+    int64_t originNs() const { return m_originNs.load(std::memory_order_relaxed); }
+
+    int64_t periodNs() const { return 60000000000LL / (int64_t(m_bpm) * m_subdiv); }
+
+    int64_t lookaheadNs() const {
+        int ms = 0;
+        for (int i = 0; i < BAND_INST_COUNT; ++i)
+            if (m_strength[i] > 0 && m_windowMs[i] > ms) ms = m_windowMs[i];
+        return int64_t(ms) * 1000000;
+    }
+
+    // 재생 시각 (0 = 퀀타이즈 꺼짐 → 즉시). shiftNs 에 원래 시각 대비 이동량을 돌려준다.
+    int64_t schedule(int inst, int64_t rxNs, int64_t *shiftNs = nullptr)
+    {
+        if (shiftNs) *shiftNs = 0;
+        if (!m_enabled || inst < 0 || inst >= BAND_INST_COUNT) return 0;
+
+        const int64_t period = periodNs();
+        const int64_t origin = m_originNs.load(std::memory_order_relaxed);
+        const int64_t rel = rxNs - origin;
+        int64_t k = rel / period;
+        if (rel % period < 0) --k;                               // 기준점 이전 (floor)
+        int64_t d = origin + k * period - rxNs;                  // 직전 그리드 선 (<= 0)
+        if (-d > period / 2) d += period;                        // 다음 선이 더 가까움
+
+        Stats &st = m_stats[inst];
+        st.events.fetch_add(1, std::memory_order_relaxed);
+        int64_t shift = 0;
+        if (std::llabs(d) <= int64_t(m_windowMs[inst]) * 1000000) {
+            shift = d * m_strength[inst] / 100;
+            st.moved.fetch_add(1, std::memory_order_relaxed);
+            const uint32_t a = uint32_t(std::llabs(shift) / 1000);
+            st.sumAbsUs.fetch_add(a, std::memory_order_relaxed);
+            if (a > st.maxAbsUs.load(std::memory_order_relaxed)) st.maxAbsUs.store(a, std::memory_order_relaxed);
+        } else {
+            st.outside.fetch_add(1, std::memory_order_relaxed);
+        }
+        st.lastUs.store(int32_t(shift / 1000), std::memory_order_relaxed);
+        if (shiftNs) *shiftNs = shift;
+        return rxNs + lookaheadNs() + shift;
+    }
+
+    const Stats &stats(int inst) const { return m_stats[inst]; }
+    void resetStats() {
+        for (Stats &s : m_stats) {
+            s.events = 0; s.moved = 0; s.outside = 0; s.sumAbsUs = 0; s.maxAbsUs = 0; s.lastUs = 0;
+        }
+    }
+
+private:
+    std::atomic<bool>    m_enabled{false};
+    std::atomic<int>     m_bpm{120};
+    std::atomic<int>     m_subdiv{2};
+    std::atomic<int64_t> m_originNs{0};
+    std::atomic<int>     m_windowMs[BAND_INST_COUNT];
+    std::atomic<int>     m_strength[BAND_INST_COUNT];
+    Stats                m_stats[BAND_INST_COUNT];
+};
+
+#endif // TEMPOGRID_H
@@ -0,0 +1,136 @@
+#include "tempowidget.h"
+#include "tempogrid.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+static const char *const kInstrumentNames[BAND_INST_COUNT] = { "Guita", "Drum", "Piano" };
+
+enum { COL_INST, COL_WINDOW, COL_STRENGTH, COL_EVENTS, COL_MOVED, COL_OUTSIDE, COL_AVG, COL_MAX, COL_LAST, COL_NUM };
+
+TempoWidget::TempoWidget(TempoGrid *tempo, QWidget *parent)
+    : QWidget(parent)
+    , m_tempo(tempo)
+{
+    auto *v = new QVBoxLayout(this);
+
+    auto *top = new QHBoxLayout;
+    m_enable = new QCheckBox(tr("Quantize"), this);
+    m_enable->setChecked(m_tempo->enabled());
+    m_bpm = new QSpinBox(this);
+    m_bpm->setRange(TempoGrid::kMinBpm, TempoGrid::kMaxBpm);
+    m_bpm->setSuffix(tr(" bpm"));
+    m_bpm->setValue(m_tempo->bpm());
+    m_subdiv = new QComboBox(this);
+    m_subdiv->addItem(tr("1/4"), 1);
+    m_subdiv->addItem(tr("1/8"), 2);
+    m_subdiv->addItem(tr("1/8 triplet"), 3);
+    m_subdiv->addItem(tr("1/16"), 4);
+    m_subdiv->setCurrentIndex(qMax(0, m_subdiv->findData(m_tempo->subdiv())));
+    m_lookahead = new QLabel(this);
+    auto *reset = new QPushButton(tr("Reset"), this);
+    top->addWidget(m_enable);
+    top->addWidget(m_bpm);
+    top->addWidget(m_subdiv);
+    top->addWidget(m_lookahead, 1);
+    top->addWidget(reset);
+    v->addLayout(top);
+
+    m_table = new QTableWidget(BAND_INST_COUNT, COL_NUM, this);
+    m_table->setHorizontalHeaderLabels({ tr("Instrument"), tr("Window (ms)"), tr("Strength (%)"),
+                                         tr("Events"), tr("Moved"), tr("Outside"),
+                                         tr("avg |shift| (ms)"), tr("max (ms)"), tr("last (ms)") });
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    for (int i = 0; i < BAND_INST_COUNT; ++i) {
+        m_table->setItem(i, COL_INST, new QTableWidgetItem(QString::fromLatin1(kInstrumentNames[i])));
+
+        m_window[i] = new QSpinBox(m_table);
+        m_window[i]->setRange(0, TempoGrid::kMaxWindowMs);
+        m_window[i]->setValue(m_tempo->windowMs(i));
+        m_window[i]->setProperty("channel", i);
+        m_table->setCellWidget(i, COL_WINDOW, m_window[i]);
+
+        m_strength[i] = new QSpinBox(m_table);
+        m_strength[i]->setRange(0, 100);
+        m_strength[i]->setSingleStep(10);
+        m_strength[i]->setValue(m_tempo->strength(i));
+        m_strength[i]->setProperty("channel", i);
+        m_table->setCellWidget(i, COL_STRENGTH, m_strength[i]);
+
+        for (int c = COL_EVENTS; c < COL_NUM; ++c) {
+            auto *item = new QTableWidgetItem;
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            m_table->setItem(i, c, item);
+        }
+
+        connect(m_window[i],   QOverload<int>::of(&QSpinBox::valueChanged), this, &TempoWidget::onChannelEdited);
+        connect(m_strength[i], QOverload<int>::of(&QSpinBox::valueChanged), this, &TempoWidget::onChannelEdited);
+    }
+    v->addWidget(m_table, 1);
+
+    connect(m_enable, &QCheckBox::toggled, this, &TempoWidget::onGridEdited);
+    connect(m_bpm, QOverload<int>::of(&QSpinBox::valueChanged), this, &TempoWidget::onGridEdited);
+    connect(m_subdiv, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &TempoWidget::onGridEdited);
+    connect(reset, &QPushButton::clicked, this, &TempoWidget::resetStats);
+    connect(&m_timer, &QTimer::timeout, this, &TempoWidget::poll);
+    m_timer.start(kPollMs);
+    refreshLookahead();
+    poll();
+}
+
+void TempoWidget::onGridEdited()
+{
+    m_tempo->setBpm(m_bpm->value());
+    m_tempo->setSubdiv(m_subdiv->currentData().toInt());
+    m_tempo->setEnabled(m_enable->isChecked());
+    refreshLookahead();
+    emit settingsChanged();
+}
+
+void TempoWidget::onChannelEdited()
+{
+    auto *sb = qobject_cast<QSpinBox*>(sender());
+    if (!sb) return;
+    const int ch = sb->property("channel").toInt();
+    m_tempo->setWindowMs(ch, m_window[ch]->value());
+    m_tempo->setStrength(ch, m_strength[ch]->value());
+    refreshLookahead();
+    emit settingsChanged();
+}
+
+void TempoWidget::refreshLookahead()
+{
+    m_lookahead->setText(tr("grid %1 ms   added delay %2 ms")
+                         .arg(m_tempo->periodNs() / 1000000.0, 0, 'f', 1)
+                         .arg(m_tempo->enabled() ? m_tempo->lookaheadNs() / 1000000 : 0));
+}
+
+void TempoWidget::poll()
+{
+    if (!isVisible()) return;
+    for (int i = 0; i < BAND_INST_COUNT; ++i) {
+        const TempoGrid::Stats &s = m_tempo->stats(i);
+        const quint64 moved = s.moved.load(std::memory_order_relaxed);
+        m_table->item(i, COL_EVENTS)->setText(QString::number(s.events.load(std::memory_order_relaxed)));
+        m_table->item(i, COL_MOVED)->setText(QString::number(moved));
+        m_table->item(i, COL_OUTSIDE)->setText(QString::number(s.outside.load(std::memory_order_relaxed)));
+        m_table->item(i, COL_AVG)->setText(moved ? QString::number(s.sumAbsUs.load() / double(moved) / 1000.0, 'f', 2) : QString());
+        m_table->item(i, COL_MAX)->setText(moved ? QString::number(s.maxAbsUs.load() / 1000.0, 'f', 2) : QString());
+        m_table->item(i, COL_LAST)->setText(QString::number(s.lastUs.load() / 1000.0, 'f', 2));
+    }
+}
+
+void TempoWidget::resetStats()
+{
+    m_tempo->resetStats();
+    poll();
+}
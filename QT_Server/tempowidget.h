@@ -0,0 +1,52 @@
+#ifndef TEMPOWIDGET_H
+#define TEMPOWIDGET_H
+
+#include <QWidget>
+#include <QTimer>
+
+#include "band_protocol.h"
+
+class TempoGrid;
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QSpinBox;
+class QTableWidget;
+
+// 템포 탭: 공유 템포 그리드(bpm, 박 분할)와 악기별 퀀타이즈 window/강도를 설정하고,
+// 네트워크 스레드가 쌓은 이벤트별 이동량 통계를 주기적으로 보여 준다.
+// 값을 바꾸면 TempoGrid 원자값에 바로 쓰고 settingsChanged() 로 저장을 요청한다.
+class TempoWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    static const int kPollMs = 250;
+
+    explicit TempoWidget(TempoGrid *tempo, QWidget *parent = nullptr);
+
+signals:
+    void settingsChanged();
+
+public slots:
+    void resetStats();
+
+private slots:
+    void poll();
+    void onGridEdited();
+    void onChannelEdited();
+
+private:
+    void refreshLookahead();
+
+    TempoGrid    *m_tempo = nullptr;
+    QTimer        m_timer;
+    QCheckBox    *m_enable = nullptr;
+    QSpinBox     *m_bpm = nullptr;
+    QComboBox    *m_subdiv = nullptr;
+    QLabel       *m_lookahead = nullptr;
+    QTableWidget *m_table = nullptr;
+    QSpinBox     *m_window[BAND_INST_COUNT] = {};
+    QSpinBox     *m_strength[BAND_INST_COUNT] = {};
+};
+
+#endif // TEMPOWIDGET_H
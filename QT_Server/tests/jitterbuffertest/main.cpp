@@ -0,0 +1,128 @@
+// JitterBuffer (jitterbuffer.h) 테스트: 재계산 후 지연, 늘릴 때/줄일 때, 상한, late 판정
+//
+// 사용법: jitterbuffertest   (실패가 있으면 종료 코드 1)
+
+#include <cstdint>
+#include <cstdio>
+
+#include "jitterbuffer.h"
+
+static int g_failed = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { std::fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+
+// 클라이언트는 10 ms 간격으로 보내고, 네트워크 지연은 base + extra[i % n] (us)
+struct Feed {
+    JitterBuffer jb;
+    uint64_t clientUs = 1000000;
+    int64_t  offsetUs = 5000000;   // 두 시계 차이 (임의)
+
+    int64_t push(int64_t extraUs, const JitterConfig &cfg, int64_t *rxNsOut = nullptr)
+    {
+        clientUs += 10000;
+        const int64_t rxNs = (int64_t(clientUs) + offsetUs + 2000 + extraUs) * 1000;
+        if (rxNsOut) *rxNsOut = rxNs;
+        return jb.playout(rxNs, clientUs, cfg);
+    }
+};
+
+static void config(JitterConfig &cfg, int pct, int maxMs)
+{
+    cfg.enabled = true;
+    cfg.percentile = pct;
+    cfg.maxDelayMs = maxMs;
+}
+
+// 지터가 0~7 ms 로 고르게 퍼지면, 100% 에서는 첫 재계산 뒤 지연 = 창 안 최대 excess
+static void testDelayAfterRecalc()
+{
+    JitterConfig cfg;
+    config(cfg, 100, 60);
+    Feed f;
+    for (int i = 0; i < JitterBuffer::kRecalcEvery - 1; ++i) f.push((i % 8) * 1000, cfg);
+    CHECK(f.jb.stats().delayUs == 0);             // 아직 재계산 전
+    CHECK(f.jb.stats().late == 0);                // 재계산 전 이벤트는 late 로 세지 않는다
+
+    f.push(0, cfg);                                // kRecalcEvery 번째 → 재계산
+    CHECK(f.jb.stats().targetUs == 7000);
+    CHECK(f.jb.stats().delayUs == 7000);           // 늘릴 때는 바로
+    CHECK(f.jb.stats().maxExcessUs == 7000);
+
+    // 이제 제때 온 이벤트는 base + delay 에 맞춰 재생: 재생 시각 - 클라이언트 시각 이 일정해야 한다
+    int64_t rx = 0;
+    const int64_t p0 = f.push(3000, cfg, &rx);
+    CHECK(p0 == rx + (7000 - 3000) * 1000);
+    const int64_t p1 = f.push(6000, cfg, &rx);
+    CHECK(p1 - p0 == 10000 * 1000);                 // 클라이언트 간격 그대로
+    CHECK(f.jb.stats().late == 0);
+
+    // 지연보다 늦게 온 이벤트 → 즉시 재생, late
+    const int64_t p2 = f.push(9000, cfg, &rx);
+    CHECK(p2 == rx);
+    CHECK(f.jb.stats().late == 1);
+}
+
+// percentile 로 꼬리를 잘라내고, 상한(maxDelayMs) 을 넘지 않는다
+static void testPercentileAndCap()
+{
+    JitterConfig cfg;
+    config(cfg, 50, 60);
+    Feed f;
+    // 절반은 0, 절반은 4 ms, 가끔 40 ms 튐
+    for (int i = 0; i < JitterBuffer::kWindow; ++i) f.push(i % 32 == 31 ? 40000 : (i % 2) * 4000, cfg);
+    CHECK(f.jb.stats().targetUs <= 4000);
+    CHECK(f.jb.stats().maxExcessUs == 40000);
+
+    JitterConfig capped;
+    config(capped, 100, 5);
+    Feed g;
+    for (int i = 0; i < JitterBuffer::kWindow; ++i) g.push((i % 4) * 10000, capped);
+    CHECK(g.jb.stats().targetUs == 5000);
+    CHECK(g.jb.stats().delayUs == 5000);
+}
+
+// 지터가 줄면 지연은 재계산마다 1/8 씩 천천히 내려간다
+static void testSlowDecay()
+{
+    JitterConfig cfg;
+    config(cfg, 100, 60);
+    Feed f;
+    for (int i = 0; i < JitterBuffer::kWindow; ++i) f.push((i % 2) * 16000, cfg);
+    CHECK(f.jb.stats().delayUs == 16000);
+
+    uint32_t prev = f.jb.stats().delayUs;
+    for (int i = 0; i < JitterBuffer::kWindow + JitterBuffer::kRecalcEvery; ++i) {
+        f.push(0, cfg);
+        const uint32_t d = f.jb.stats().delayUs;
+        CHECK(d <= prev);
+        CHECK(prev - d <= prev / 8 + 1);
+        prev = d;
+    }
+    CHECK(f.jb.stats().targetUs == 0);
+    CHECK(prev > 0 && prev < 16000);
+}
+
+// 꺼져 있으면 추정만 하고 수신 시각 그대로
+static void testDisabled()
+{
+    JitterConfig cfg;
+    Feed f;
+    int64_t rx = 0;
+    for (int i = 0; i < 40; ++i) CHECK(f.push((i % 5) * 1000, cfg, &rx) == rx);
+    CHECK(f.jb.stats().events == 40);
+    CHECK(f.jb.stats().late == 0);
+    CHECK(f.jb.stats().delayUs == 4000);
+}
+
+int main()
+{
+    testDelayAfterRecalc();
+    testPercentileAndCap();
+    testSlowDecay();
+    testDisabled();
+    if (g_failed) { std::fprintf(stderr, "jitterbuffertest: %d check(s) failed\n", g_failed); return 1; }
+    std::printf("jitterbuffertest: OK\n");
+    return 0;
+}
@@ -0,0 +1,86 @@
+// LatencyHistogram (latencystats.h) 테스트: 버킷 경계, 상대오차, percentile
+//
+// 사용법: latencystatstest   (실패가 있으면 종료 코드 1)
+
+#include <cstdint>
+#include <cstdio>
+
+#include "latencystats.h"
+
+static int g_failed = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { std::fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+
+typedef LatencyHistogram H;
+
+// 모든 버킷이 빈틈/겹침 없이 이어지고 양 끝값이 제 버킷에 들어가는지
+static void testBucketBoundaries()
+{
+    CHECK(H::bucketLow(0) == 0);
+    for (int i = 0; i < H::kBuckets; ++i) {
+        const uint32_t lo = H::bucketLow(i);
+        const uint32_t hi = uint32_t(uint64_t(lo) + H::bucketWidth(i) - 1);
+        CHECK(H::bucketOf(lo) == i);
+        CHECK(H::bucketOf(hi) == i);
+        if (i > 0) CHECK(H::bucketOf(lo - 1) == i - 1);
+        if (i + 1 < H::kBuckets) CHECK(H::bucketLow(i + 1) == hi + 1);
+    }
+    // 마지막 버킷이 uint32 끝까지 덮는다
+    const int last = H::kBuckets - 1;
+    CHECK(uint64_t(H::bucketLow(last)) + H::bucketWidth(last) - 1 == 0xFFFFFFFFull);
+    CHECK(H::bucketOf(0xFFFFFFFFu) == last);
+
+    // 1us 구간 → 로그 구간 전환점
+    CHECK(H::bucketOf(15) == 15);
+    CHECK(H::bucketOf(16) == 16);
+    CHECK(H::bucketWidth(16) == 1);
+    CHECK(H::bucketOf(31) == 31);
+    CHECK(H::bucketOf(32) == 32);
+    CHECK(H::bucketWidth(32) == 2);
+    CHECK(H::bucketOf(33) == 32);
+    CHECK(H::bucketOf(34) == 33);
+}
+
+// 16 이상에서 버킷 폭 / 하한 <= 1/16 (상대오차 ~6%)
+static void testRelativeError()
+{
+    for (int i = H::kSub; i < H::kBuckets; ++i)
+        CHECK(uint64_t(H::bucketWidth(i)) * 16 <= H::bucketLow(i));
+}
+
+static void testPercentile()
+{
+    H h;
+    CHECK(h.percentile(50) == 0);   // 비어 있음
+    CHECK(h.count() == 0);
+
+    for (uint32_t v = 1; v <= 100; ++v) h.record(v);
+    CHECK(h.count() == 100);
+    CHECK(h.max() == 100);
+    CHECK(h.percentile(100) == 100);
+    CHECK(h.percentile(0) == 1);                 // rank 최소 1
+    CHECK(h.percentile(10) == 10);               // 1us 구간은 정확
+    CHECK(h.percentile(50) == 51);               // 50 은 [50,51] 버킷 → 상한 51
+    CHECK(h.percentile(99) == 99);               // 99 는 [96,99] 버킷
+
+    // 버킷 상한이 max 를 넘으면 max 로 자른다
+    H one;
+    one.record(1000);
+    CHECK(one.percentile(50) == 1000);
+    CHECK(one.bucketCount(H::bucketOf(1000)) == 1);
+
+    h.reset();
+    CHECK(h.count() == 0 && h.max() == 0 && h.percentile(99) == 0);
+}
+
+int main()
+{
+    testBucketBoundaries();
+    testRelativeError();
+    testPercentile();
+    if (g_failed) { std::fprintf(stderr, "latencystatstest: %d check(s) failed\n", g_failed); return 1; }
+    std::printf("latencystatstest: OK\n");
+    return 0;
+}
@@ -0,0 +1,96 @@
+// SeqWindow (seqwindow.h) 테스트: 중복/역순/늦음 판정과 손실 추정, seq 가 2^32 에서 0 으로 넘어갈 때
+//
+// 사용법: seqwindowtest   (실패가 있으면 종료 코드 1)
+
+#include <cstdint>
+#include <cstdio>
+
+#include "seqwindow.h"
+
+static int g_failed = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { std::fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+
+static const uint64_t kDeadlineUs = 40000;
+
+// start 부터 순서대로/빠짐/중복/역순을 섞어 보낸다. start 를 바꿔 랩 전후 모두 확인
+static void testVerdicts(uint32_t start)
+{
+    SeqWindow w;
+    uint64_t ts = 1000000;
+    CHECK(w.offer(start, ts, kDeadlineUs) == SeqWindow::Accept);
+    CHECK(w.offer(start + 1, ts += 1000, kDeadlineUs) == SeqWindow::Accept);
+    CHECK(w.offer(start + 1, ts, kDeadlineUs) == SeqWindow::Duplicate);
+
+    // start+2, +3 을 건너뜀 → 손실 2
+    CHECK(w.offer(start + 4, ts += 3000, kDeadlineUs) == SeqWindow::Accept);
+    CHECK(w.stats().lost == 2);
+
+    // 빠졌던 +2 가 마감 안에 도착 → 역순 수락, 손실 1
+    CHECK(w.offer(start + 2, ts - 2000, kDeadlineUs) == SeqWindow::AcceptReordered);
+    CHECK(w.stats().lost == 1);
+    CHECK(w.offer(start + 2, ts - 2000, kDeadlineUs) == SeqWindow::Duplicate);
+
+    // +3 은 마감을 넘겨 도착 → 늦음 (버림), 손실에서는 빠진다
+    CHECK(w.offer(start + 3, ts - kDeadlineUs - 1, kDeadlineUs) == SeqWindow::Late);
+    CHECK(w.stats().lost == 0);
+
+    // 창(64) 밖의 옛 번호 → 늦음
+    CHECK(w.offer(start + 4 - 64, ts - 100, kDeadlineUs) == SeqWindow::Late);
+    // 창 가장자리(63 뒤)는 아직 판정 가능: 받은 적 없으니 역순으로 수락
+    CHECK(w.offer(start + 4 - 63, ts - 100, kDeadlineUs) == SeqWindow::AcceptReordered);
+
+    const SeqWindow::Stats &s = w.stats();
+    CHECK(s.received   == 9);
+    CHECK(s.accepted   == 5);
+    CHECK(s.duplicates == 2);
+    CHECK(s.reordered  == 2);
+    CHECK(s.late       == 2);
+    CHECK(s.accepted + s.duplicates + s.late == s.received);
+}
+
+// seq 가 0xFFFFFFFF → 0 으로 넘어가도 "새 번호" 로 봐야 한다
+static void testWrap()
+{
+    SeqWindow w;
+    uint64_t ts = 0;
+    uint32_t seq = 0xFFFFFFF0u;
+    for (int i = 0; i < 32; ++i)
+        CHECK(w.offer(seq++, ts += 1000, kDeadlineUs) == SeqWindow::Accept);
+    CHECK(seq == 0x10u);
+    CHECK(w.stats().lost == 0);
+
+    // 랩 직전 번호의 재전송 → 중복 (역순이 아니라)
+    CHECK(w.offer(0xFFFFFFFFu, ts, kDeadlineUs) == SeqWindow::Duplicate);
+
+    // 랩을 가로질러 하나 건너뜀: 0x10 을 빼고 0x11 → 손실 1, 뒤늦은 0x10 → 역순 수락
+    CHECK(w.offer(0x11u, ts += 2000, kDeadlineUs) == SeqWindow::Accept);
+    CHECK(w.stats().lost == 1);
+    CHECK(w.offer(0x10u, ts - 1000, kDeadlineUs) == SeqWindow::AcceptReordered);
+    CHECK(w.stats().lost == 0);
+}
+
+// 64 이상 건너뛰면 비트맵을 새로 시작 (시프트 오버플로 없이)
+static void testBigGap()
+{
+    SeqWindow w;
+    CHECK(w.offer(10, 0, kDeadlineUs) == SeqWindow::Accept);
+    CHECK(w.offer(10 + 200, 1000, kDeadlineUs) == SeqWindow::Accept);
+    CHECK(w.stats().lost == 199);
+    CHECK(w.offer(10 + 200, 1000, kDeadlineUs) == SeqWindow::Duplicate);
+    CHECK(w.offer(10 + 199, 1000, kDeadlineUs) == SeqWindow::AcceptReordered);
+    CHECK(w.offer(10, 1000, kDeadlineUs) == SeqWindow::Late);
+}
+
+int main()
+{
+    testVerdicts(100);
+    testVerdicts(0xFFFFFFFEu);   // 중간에 랩
+    testWrap();
+    testBigGap();
+    if (g_failed) { std::fprintf(stderr, "seqwindowtest: %d check(s) failed\n", g_failed); return 1; }
+    std::printf("seqwindowtest: OK\n");
+    return 0;
+}
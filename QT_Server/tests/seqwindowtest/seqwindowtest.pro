@@ -0,0 +1,17 @@
+# SeqWindow 단위 테스트 (Qt 라이브러리 비의존, qmake 는 빌드용으로만 사용). make check 로 실행
+CONFIG += c++11 console
+CONFIG -= app_bundle qt
+
+TARGET = seqwindowtest
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../../seqwindow.h
+
+check.commands = ./$$TARGET
+check.depends = $$TARGET
+QMAKE_EXTRA_TARGETS += check
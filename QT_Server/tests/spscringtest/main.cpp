@@ -0,0 +1,83 @@
+// SpscRing (spscring.h) 테스트: 빈/가득 판정, 인덱스 랩어라운드, 두 스레드 사이 순서 보존
+//
+// 사용법: spscringtest   (실패가 있으면 종료 코드 1)
+
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#include "spscring.h"
+
+static int g_failed = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { std::fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+
+static void testEmptyFull()
+{
+    SpscRing<int, 4> r;
+    int v = -1;
+    CHECK(r.size() == 0);
+    CHECK(!r.pop(v));
+    CHECK(v == -1);                  // 실패한 pop 은 out 을 건드리지 않는다
+
+    for (int i = 0; i < 4; ++i) CHECK(r.push(i));
+    CHECK(r.size() == 4);
+    CHECK(!r.push(99));              // 가득 참
+    CHECK(r.size() == 4);
+
+    CHECK(r.pop(v) && v == 0);
+    CHECK(r.push(4));                // 한 칸 비면 다시 들어간다
+    CHECK(!r.push(5));
+    for (int want = 1; want <= 4; ++want) CHECK(r.pop(v) && v == want);
+    CHECK(!r.pop(v));
+    CHECK(r.size() == 0);
+}
+
+// head/tail 이 용량을 여러 번 넘어가도 (h & (N-1)) 위치와 size() 가 맞는지
+static void testWrapAround()
+{
+    SpscRing<uint32_t, 8> r;
+    uint32_t next = 0, expect = 0, v = 0;
+    for (int round = 0; round < 1000; ++round) {
+        const int burst = 1 + round % 8;   // 1~8 개씩 넣고 빼서 매번 다른 위치에서 랩
+        for (int i = 0; i < burst; ++i) CHECK(r.push(next++));
+        CHECK(r.size() == size_t(burst));
+        for (int i = 0; i < burst; ++i) CHECK(r.pop(v) && v == expect++);
+        CHECK(!r.pop(v));
+    }
+    CHECK(next == expect);
+}
+
+// 생산자/소비자 스레드 1개씩: 빠짐/중복/역순 없이 전부 도착해야 한다
+static void testTwoThreads()
+{
+    static SpscRing<uint64_t, 64> r;
+    const uint64_t kCount = 2000000;
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < kCount; ) {
+            if (r.push(i)) ++i;
+            else std::this_thread::yield();
+        }
+    });
+    uint64_t expect = 0, v = 0, bad = 0;
+    while (expect < kCount) {
+        if (!r.pop(v)) { std::this_thread::yield(); continue; }
+        if (v != expect) ++bad;
+        expect = v + 1;
+    }
+    producer.join();
+    CHECK(bad == 0);
+    CHECK(!r.pop(v));
+}
+
+int main()
+{
+    testEmptyFull();
+    testWrapAround();
+    testTwoThreads();
+    if (g_failed) { std::fprintf(stderr, "spscringtest: %d check(s) failed\n", g_failed); return 1; }
+    std::printf("spscringtest: OK\n");
+    return 0;
+}
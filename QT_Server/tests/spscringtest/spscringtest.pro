@@ -0,0 +1,18 @@
+# SpscRing 단위 테스트 (Qt 라이브러리 비의존, qmake 는 빌드용으로만 사용). make check 로 실행
+CONFIG += c++11 console
+CONFIG -= app_bundle qt
+
+TARGET = spscringtest
+
+INCLUDEPATH += ../..
+LIBS += -pthread
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../../spscring.h
+
+check.commands = ./$$TARGET
+check.depends = $$TARGET
+QMAKE_EXTRA_TARGETS += check
@@ -0,0 +1,129 @@
+// TempoGrid (tempogrid.h) 테스트: 그리드 스냅, window 경계, strength 0/50/100%, lookahead
+//
+// 사용법: tempogridtest   (실패가 있으면 종료 코드 1)
+
+#include <cstdint>
+#include <cstdio>
+
+#include "tempogrid.h"
+
+static int g_failed = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { std::fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+
+static const int64_t kMs = 1000000;
+
+// 120 bpm, 8분 → 250 ms 격자. 드럼 window 30 ms, 나머지는 꺼 둔다 (strength 0)
+static void setup(TempoGrid &g, int strength)
+{
+    g.setBpm(120);
+    g.setSubdiv(2);
+    for (int i = 0; i < BAND_INST_COUNT; ++i) { g.setWindowMs(i, 30); g.setStrength(i, 0); }
+    g.setStrength(BAND_INST_DRUM, strength);
+    g.setEnabled(true);
+}
+
+static void testSnapAndWindowEdge()
+{
+    TempoGrid g;
+    setup(g, 100);
+    CHECK(g.periodNs() == 250 * kMs);
+    CHECK(g.lookaheadNs() == 30 * kMs);
+
+    const int64_t line = g.originNs() + 40 * g.periodNs();
+    const int64_t la = g.lookaheadNs();
+    int64_t shift = 0;
+
+    // 늦게 친 타격: 정확히 window 경계(30 ms) 는 옮긴다
+    CHECK(g.schedule(BAND_INST_DRUM, line + 30 * kMs, &shift) == line + la);
+    CHECK(shift == -30 * kMs);
+    // 1 ns 만 넘어도 그대로 둔다
+    CHECK(g.schedule(BAND_INST_DRUM, line + 30 * kMs + 1, &shift) == line + 30 * kMs + 1 + la);
+    CHECK(shift == 0);
+    // 일찍 친 타격: 앞쪽 경계도 같다 (다음 선으로 밀기)
+    CHECK(g.schedule(BAND_INST_DRUM, line - 30 * kMs, &shift) == line + la);
+    CHECK(shift == 30 * kMs);
+    CHECK(g.schedule(BAND_INST_DRUM, line - 30 * kMs - 1, &shift) == line - 30 * kMs - 1 + la);
+    // 선 위의 타격은 이동 없음
+    CHECK(g.schedule(BAND_INST_DRUM, line, &shift) == line + la);
+    CHECK(shift == 0);
+
+    const TempoGrid::Stats &st = g.stats(BAND_INST_DRUM);
+    CHECK(st.events == 5);
+    CHECK(st.moved == 3);
+    CHECK(st.outside == 2);
+    CHECK(st.maxAbsUs == 30000);
+}
+
+// 기준점 이전 시각도 floor 로 가장 가까운 선을 찾는다
+static void testBeforeOrigin()
+{
+    TempoGrid g;
+    setup(g, 100);
+    const int64_t line = g.originNs() - 3 * g.periodNs();
+    int64_t shift = 0;
+    g.schedule(BAND_INST_DRUM, line + 10 * kMs, &shift);
+    CHECK(shift == -10 * kMs);
+    g.schedule(BAND_INST_DRUM, line - 10 * kMs, &shift);
+    CHECK(shift == 10 * kMs);
+}
+
+static void testStrength()
+{
+    int64_t shift = 0;
+    {
+        TempoGrid g;
+        setup(g, 0);                                   // 0%: window 안이어도 옮기지 않고, lookahead 도 0
+        CHECK(g.lookaheadNs() == 0);
+        const int64_t rx = g.originNs() + 8 * g.periodNs() + 20 * kMs;
+        CHECK(g.schedule(BAND_INST_DRUM, rx, &shift) == rx);
+        CHECK(shift == 0);
+    }
+    {
+        TempoGrid g;
+        setup(g, 50);                                  // 50%: 절반만
+        const int64_t rx = g.originNs() + 8 * g.periodNs() + 20 * kMs;
+        CHECK(g.schedule(BAND_INST_DRUM, rx, &shift) == rx + g.lookaheadNs() - 10 * kMs);
+        CHECK(shift == -10 * kMs);
+    }
+    {
+        TempoGrid g;
+        setup(g, 100);                                 // 100%: 선에 정확히
+        const int64_t line = g.originNs() + 8 * g.periodNs();
+        CHECK(g.schedule(BAND_INST_DRUM, line + 20 * kMs, &shift) == line + g.lookaheadNs());
+    }
+}
+
+// lookahead 는 켜진 악기 중 가장 큰 window, 모든 악기에 같은 값
+static void testLookaheadAndDisabled()
+{
+    TempoGrid g;
+    setup(g, 100);
+    g.setStrength(BAND_INST_PIANO, 100);
+    g.setWindowMs(BAND_INST_PIANO, 80);
+    CHECK(g.lookaheadNs() == 80 * kMs);
+    const int64_t rx = g.originNs() + 4 * g.periodNs() + 100 * kMs;   // 드럼 window 밖 → 이동 없이 lookahead 만
+    CHECK(g.schedule(BAND_INST_DRUM, rx) == rx + 80 * kMs);
+
+    g.setWindowMs(BAND_INST_PIANO, 500);
+    CHECK(g.windowMs(BAND_INST_PIANO) == TempoGrid::kMaxWindowMs);
+
+    g.setEnabled(false);
+    int64_t shift = 1;
+    CHECK(g.schedule(BAND_INST_DRUM, rx, &shift) == 0);   // 꺼짐 → 즉시
+    CHECK(shift == 0);
+    CHECK(g.schedule(BAND_INST_COUNT, rx) == 0);
+}
+
+int main()
+{
+    testSnapAndWindowEdge();
+    testBeforeOrigin();
+    testStrength();
+    testLookaheadAndDisabled();
+    if (g_failed) { std::fprintf(stderr, "tempogridtest: %d check(s) failed\n", g_failed); return 1; }
+    std::printf("tempogridtest: OK\n");
+    return 0;
+}
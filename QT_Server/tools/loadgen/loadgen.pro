@@ -0,0 +1,13 @@
+# QT_Server 부하 생성기 (Qt 라이브러리 비의존, POSIX 소켓 + std::thread)
+CONFIG += c++11 console thread
+CONFIG -= app_bundle qt
+
+TARGET = loadgen
+
+INCLUDEPATH += ../.. ../../../common
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../../../common/band_protocol.h
@@ -0,0 +1,313 @@
+// QT_Server 부하 생성기 / 처리량 벤치마크
+//
+// 사용법: loadgen [옵션]
+//   -H host      서버 주소 (127.0.0.1)
+//   -p port      포트 (5000)
+//   -a file      id/pw 목록 (QT_Server/idpasswd.txt 형식, 기본 ./idpasswd.txt)
+//   -c N         동시 접속 수 (4). 접속 i 는 목록의 i 번째 id 로 로그인
+//   -r rate      접속당 초당 이벤트 수 (50)
+//   -b burst     한 번에 몰아 보내는 이벤트 수 (1). 주기는 burst/rate 초
+//   -d sec       측정 시간 (10)
+//   -i list      악기 순환 목록 drum,piano,guita (기본 전부). 접속 i 는 i 번째부터 순환
+//   -P ms        PING 간격 (200, 0=끔)
+//
+// 서버는 null 싱크로 띄우면 오디오 장치 없이도 엔진이 실시간으로 큐를 소비한다.
+//   ./QT_Server_headless -a null                 (또는 QT_SERVER_AUDIO=null ./QT_Server/QT_Server 후 Start)
+//   ./loadgen -a QT_Server/idpasswd.txt -c 8 -r 200 -b 4 -d 20
+//
+// 결과: 보낸 이벤트/s, 서버가 엔진 큐에 넣은 이벤트/s ([STATS] posted 증가분),
+//       큐가 가득 차 버린 수 (dropped 증가분), PING 왕복 시간 p50/p95/p99/max.
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "band_protocol.h"
+
+namespace {
+
+struct Options {
+    std::string host = "127.0.0.1";
+    int port = 5000;
+    std::string idFile = "idpasswd.txt";
+    int conns = 4;
+    double rate = 50.0;
+    int burst = 1;
+    double seconds = 10.0;
+    std::vector<int> instruments = { BAND_INST_DRUM, BAND_INST_PIANO, BAND_INST_GUITA };
+    int pingMs = 200;
+};
+
+struct ServerStats {
+    bool ok = false;
+    unsigned long long posted = 0, dropped = 0, consumed = 0, depthMax = 0, waitAvgUs = 0, waitMaxUs = 0;
+    unsigned long long logDropped = 0;   // 서버 로그 링 드롭 (없으면 0)
+};
+
+struct ConnResult {
+    bool connected = false;
+    unsigned long long sent = 0;
+    std::vector<uint32_t> rttUs;
+};
+
+std::atomic<bool> g_stop{false};
+
+int connectLogin(const Options &o, const std::pair<std::string, std::string> &cred)
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) { std::perror("socket"); return -1; }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(uint16_t(o.port));
+    if (::inet_pton(AF_INET, o.host.c_str(), &addr.sin_addr) != 1 ||
+        ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::perror("connect");
+        ::close(fd);
+        return -1;
+    }
+    const std::string login = cred.first + ":" + cred.second + "\n";
+    if (::send(fd, login.data(), login.size(), MSG_NOSIGNAL) != ssize_t(login.size())) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const std::string &s)
+{
+    size_t off = 0;
+    while (off < s.size()) {
+        const ssize_t n = ::send(fd, s.data() + off, s.size() - off, MSG_NOSIGNAL);
+        if (n < 0) { if (errno == EINTR) continue; return false; }
+        off += size_t(n);
+    }
+    return true;
+}
+
+void appendEvent(std::string &out, int instrument, unsigned long long i)
+{
+    static const char PIANO[] = "CDEFGAB";
+    static const char GUITA[] = "GDC";
+    switch (instrument) {
+    case BAND_INST_DRUM:  out += "[DRUM]";  out += char('0' + i % 5); break;
+    case BAND_INST_PIANO: out += "[PIANO]"; out += PIANO[i % 7];      break;
+    default:              out += "[GUITA]"; out += GUITA[i % 3];      break;
+    }
+    out += '\n';
+}
+
+// 줄 단위 수신 (rx 에 이어 붙이고 완성된 줄을 꺼낸다)
+bool popLine(std::string &rx, std::string &line)
+{
+    const size_t nl = rx.find('\n');
+    if (nl == std::string::npos) return false;
+    line.assign(rx, 0, nl);
+    rx.erase(0, nl + 1);
+    return true;
+}
+
+ServerStats queryStats(const Options &o, const std::pair<std::string, std::string> &cred)
+{
+    ServerStats s;
+    const int fd = connectLogin(o, cred);
+    if (fd < 0) return s;
+    sendAll(fd, "[STATS]\n");
+    std::string rx, line;
+    char buf[512];
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!s.ok && std::chrono::steady_clock::now() < deadline) {
+        pollfd p = { fd, POLLIN, 0 };
+        if (::poll(&p, 1, 100) <= 0) continue;
+        const ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) break;
+        rx.append(buf, size_t(n));
+        while (popLine(rx, line)) {
+            if (line.compare(0, 6, "STATS ") != 0) continue;
+            s.ok = std::sscanf(line.c_str(), "STATS posted=%llu dropped=%llu consumed=%llu depthMax=%llu waitAvgUs=%llu waitMaxUs=%llu",
+                               &s.posted, &s.dropped, &s.consumed, &s.depthMax, &s.waitAvgUs, &s.waitMaxUs) == 6;
+            if (const char *ld = std::strstr(line.c_str(), " logDropped="))
+                s.logDropped = std::strtoull(ld + 12, nullptr, 10);
+        }
+    }
+    ::close(fd);
+    return s;
+}
+
+void runConnection(const Options &o, int index, const std::pair<std::string, std::string> &cred, ConnResult &res)
+{
+    const int fd = connectLogin(o, cred);
+    if (fd < 0) return;
+    res.connected = true;
+
+    using clock = std::chrono::steady_clock;
+    const auto period = std::chrono::nanoseconds(int64_t(1e9 * o.burst / o.rate));
+    const auto pingPeriod = std::chrono::milliseconds(o.pingMs);
+    auto nextSend = clock::now();
+    auto nextPing = nextSend + pingPeriod;
+
+    std::string tx, rx, line;
+    char buf[4096];
+    unsigned long long k = 0;
+    while (!g_stop.load(std::memory_order_relaxed)) {
+        const auto now = clock::now();
+        if (now >= nextSend) {
+            tx.clear();
+            for (int b = 0; b < o.burst; ++b, ++k)
+                appendEvent(tx, o.instruments[(size_t(index) + k) % o.instruments.size()], k);
+            if (!sendAll(fd, tx)) break;
+            res.sent += unsigned(o.burst);
+            nextSend += period;
+            if (now - nextSend > std::chrono::seconds(1)) nextSend = now;   // 너무 밀리면 따라잡기 포기
+        }
+        if (o.pingMs > 0 && now >= nextPing) {
+            if (!sendAll(fd, "[PING]" + std::to_string(band_now_us()) + "\n")) break;
+            nextPing += pingPeriod;
+        }
+
+        const auto wake = std::min(nextSend, o.pingMs > 0 ? nextPing : nextSend);
+        const int waitMs = int(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(wake - clock::now()).count()));
+        pollfd p = { fd, POLLIN, 0 };
+        if (::poll(&p, 1, waitMs) > 0) {
+            const ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) break;
+            rx.append(buf, size_t(n));
+            while (popLine(rx, line)) {
+                if (line.compare(0, 5, "PONG ") != 0) continue;
+                const unsigned long long sentUs = std::strtoull(line.c_str() + 5, nullptr, 10);
+                res.rttUs.push_back(uint32_t(band_now_us() - sentUs));
+            }
+        }
+    }
+    ::close(fd);
+}
+
+std::vector<std::pair<std::string, std::string>> loadCredentials(const std::string &path)
+{
+    std::vector<std::pair<std::string, std::string>> out;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream ss(line);
+        std::string id, pw;
+        if (!(ss >> id >> pw) || id[0] == '#') continue;
+        out.emplace_back(id, pw);
+    }
+    return out;
+}
+
+uint32_t pct(const std::vector<uint32_t> &v, double p)
+{
+    if (v.empty()) return 0;
+    size_t i = size_t(p / 100.0 * double(v.size()));
+    return v[std::min(i, v.size() - 1)];
+}
+
+int usage()
+{
+    std::fprintf(stderr, "usage: loadgen [-H host] [-p port] [-a idpasswd.txt] [-c conns] [-r rate] [-b burst]\n"
+                         "               [-d seconds] [-i drum,piano,guita] [-P ping_ms]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!v) return usage();
+        ++i;
+        if      (a == "-H") o.host = v;
+        else if (a == "-p") o.port = std::atoi(v);
+        else if (a == "-a") o.idFile = v;
+        else if (a == "-c") o.conns = std::atoi(v);
+        else if (a == "-r") o.rate = std::atof(v);
+        else if (a == "-b") o.burst = std::atoi(v);
+        else if (a == "-d") o.seconds = std::atof(v);
+        else if (a == "-P") o.pingMs = std::atoi(v);
+        else if (a == "-i") {
+            o.instruments.clear();
+            std::istringstream ss(v);
+            std::string t;
+            while (std::getline(ss, t, ',')) {
+                if (t == "drum")       o.instruments.push_back(BAND_INST_DRUM);
+                else if (t == "piano") o.instruments.push_back(BAND_INST_PIANO);
+                else if (t == "guita") o.instruments.push_back(BAND_INST_GUITA);
+                else return usage();
+            }
+        }
+        else return usage();
+    }
+    if (o.conns <= 0 || o.rate <= 0 || o.burst <= 0 || o.seconds <= 0 || o.instruments.empty()) return usage();
+
+    const auto creds = loadCredentials(o.idFile);
+    if (creds.empty()) { std::fprintf(stderr, "no id/pw pairs in %s\n", o.idFile.c_str()); return 1; }
+    if (size_t(o.conns) > creds.size())
+        std::fprintf(stderr, "note: %d connections but %zu ids -> ids are reused\n", o.conns, creds.size());
+
+    const ServerStats before = queryStats(o, creds[0]);
+    if (!before.ok) std::fprintf(stderr, "warning: server did not answer [STATS] (old server?)\n");
+
+    std::vector<ConnResult> results(size_t(o.conns));
+    std::vector<std::thread> threads;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < o.conns; ++i)
+        threads.emplace_back(runConnection, std::cref(o), i, std::cref(creds[size_t(i) % creds.size()]), std::ref(results[size_t(i)]));
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(o.seconds));
+    g_stop = true;
+    for (std::thread &t : threads) t.join();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // 서버가 남은 줄을 처리할 시간을 조금 준 뒤 집계
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    const ServerStats after = queryStats(o, creds[0]);
+
+    unsigned long long sent = 0;
+    int connected = 0;
+    std::vector<uint32_t> rtt;
+    for (const ConnResult &r : results) {
+        sent += r.sent;
+        connected += r.connected ? 1 : 0;
+        rtt.insert(rtt.end(), r.rttUs.begin(), r.rttUs.end());
+    }
+    std::sort(rtt.begin(), rtt.end());
+
+    std::printf("connections : %d/%d   rate %.0f/s x burst %d   %.1f s\n", connected, o.conns, o.rate, o.burst, elapsed);
+    std::printf("sent        : %llu events (%.0f/s)\n", sent, double(sent) / elapsed);
+    if (before.ok && after.ok) {
+        const unsigned long long posted = after.posted - before.posted;
+        const unsigned long long dropped = after.dropped - before.dropped;
+        std::printf("accepted    : %llu events (%.0f/s), %.1f%% of sent\n", posted, double(posted) / elapsed,
+                    sent ? 100.0 * double(posted) / double(sent) : 0.0);
+        std::printf("server drop : %llu (engine queue full)   queue depthMax %llu   wait avg %llu us max %llu us\n",
+                    dropped, after.depthMax, after.waitAvgUs, after.waitMaxUs);
+        if (after.logDropped > before.logDropped)
+            std::printf("server log  : %llu records dropped (log ring full)\n", after.logDropped - before.logDropped);
+    }
+    if (!rtt.empty())
+        std::printf("ping rtt    : n=%zu  p50 %u us  p95 %u us  p99 %u us  max %u us\n",
+                    rtt.size(), pct(rtt, 50), pct(rtt, 95), pct(rtt, 99), rtt.back());
+    return connected == o.conns ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+// WAV 파일들 → 패킹된 샘플 뱅크 (samplebank.h 포맷)
+//
+// 사용법: mkbank [-r 48000] -o samples.bank a.wav b.wav ...
+//   - 각 WAV 를 엔진 출력 포맷(스테레오 int16, -r 레이트)으로 변환해 한 파일에 넣는다
+//   - 엔트리 이름 = 확장자 없는 파일명 (서버는 "PIANO_C", "kick" 등으로 찾는다)
+//
+// 예) cd QT_Server && ./tools/mkbank/mkbank -o samples.bank *.wav
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "samplebank.h"
+#include "wavdecoder.h"
+
+static bool readFile(const std::string &path, std::vector<char> &out)
+{
+    FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    std::fseek(f, 0, SEEK_END);
+    const long n = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    out.resize(n > 0 ? size_t(n) : 0);
+    const bool ok = n >= 0 && std::fread(out.data(), 1, out.size(), f) == out.size();
+    std::fclose(f);
+    return ok;
+}
+
+static std::string baseName(const std::string &path)
+{
+    const size_t slash = path.find_last_of("/\\");
+    std::string s = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    const size_t dot = s.find_last_of('.');
+    return (dot == std::string::npos) ? s : s.substr(0, dot);
+}
+
+static int usage()
+{
+    std::fprintf(stderr, "usage: mkbank [-r rate] -o out.bank in1.wav [in2.wav ...]\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    int rate = 48000;
+    std::string outPath;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-o") && i + 1 < argc)      outPath = argv[++i];
+        else if (!std::strcmp(argv[i], "-r") && i + 1 < argc) rate = std::atoi(argv[++i]);
+        else if (argv[i][0] == '-')                            return usage();
+        else                                                   inputs.push_back(argv[i]);
+    }
+    if (outPath.empty() || inputs.empty() || rate <= 0) return usage();
+
+    struct Item { std::string name; std::vector<int16_t> pcm; };
+    std::vector<Item> items;
+    size_t inBytes = 0;
+    for (const std::string &path : inputs) {
+        std::vector<char> raw;
+        if (!readFile(path, raw)) { std::fprintf(stderr, "read fail: %s\n", path.c_str()); return 1; }
+        inBytes += raw.size();
+
+        Item it;
+        it.name = baseName(path);
+        if (it.name.size() >= size_t(kSampleBankNameLen)) {
+            std::fprintf(stderr, "name too long (max %d): %s\n", kSampleBankNameLen - 1, it.name.c_str());
+            return 1;
+        }
+        std::string err;
+        if (!decodeWavToStereo16(raw.data(), raw.size(), rate, it.pcm, &err)) {
+            std::fprintf(stderr, "decode fail: %s (%s)\n", path.c_str(), err.c_str());
+            return 1;
+        }
+        for (const Item &o : items)
+            if (o.name == it.name) { std::fprintf(stderr, "duplicate name: %s\n", it.name.c_str()); return 1; }
+        items.push_back(std::move(it));
+    }
+
+    // 레이아웃 계산
+    std::vector<SampleBankEntry> index(items.size());
+    uint64_t off = sampleBankAlignUp(sizeof(SampleBankHeader) + index.size() * sizeof(SampleBankEntry));
+    for (size_t i = 0; i < items.size(); ++i) {
+        std::memset(&index[i], 0, sizeof(SampleBankEntry));
+        std::memcpy(index[i].name, items[i].name.data(), items[i].name.size());
+        index[i].offset = off;
+        index[i].frames = uint32_t(items[i].pcm.size() / 2);
+        off = sampleBankAlignUp(off + items[i].pcm.size() * sizeof(int16_t));
+    }
+
+    SampleBankHeader hdr;
+    std::memcpy(hdr.magic, kSampleBankMagic, sizeof(hdr.magic));
+    hdr.version    = kSampleBankVersion;
+    hdr.sampleRate = uint32_t(rate);
+    hdr.channels   = 2;
+    hdr.count      = uint32_t(items.size());
+    hdr.fileBytes  = off;
+
+    // 이 도구와 서버는 little-endian 호스트를 가정한다 (x86/ARM 리눅스)
+    std::vector<char> out(size_t(off), 0);
+    std::memcpy(out.data(), &hdr, sizeof(hdr));
+    std::memcpy(out.data() + sizeof(hdr), index.data(), index.size() * sizeof(SampleBankEntry));
+    for (size_t i = 0; i < items.size(); ++i)
+        std::memcpy(out.data() + index[i].offset, items[i].pcm.data(), items[i].pcm.size() * sizeof(int16_t));
+
+    FILE *f = std::fopen(outPath.c_str(), "wb");
+    if (!f || std::fwrite(out.data(), 1, out.size(), f) != out.size()) {
+        std::fprintf(stderr, "write fail: %s\n", outPath.c_str());
+        if (f) std::fclose(f);
+        return 1;
+    }
+    std::fclose(f);
+
+    // 생성 결과를 다시 파싱해 확인
+    SampleBankView view;
+    std::string err;
+    if (!view.open(out.data(), out.size(), &err)) { std::fprintf(stderr, "self-check fail: %s\n", err.c_str()); return 1; }
+
+    for (size_t i = 0; i < items.size(); ++i)
+        std::printf("  %-16s %8u frames  %6.2f s\n", items[i].name.c_str(), index[i].frames,
+                    double(index[i].frames) / rate);
+    std::printf("%s: %zu samples, %d Hz stereo, %.2f MB (wav input %.2f MB)\n", outPath.c_str(), items.size(),
+                rate, double(off) / (1024.0 * 1024.0), double(inBytes) / (1024.0 * 1024.0));
+    return 0;
+}
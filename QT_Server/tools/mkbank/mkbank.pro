@@ -0,0 +1,15 @@
+# 오프라인 샘플 뱅크 생성기 (Qt 라이브러리 비의존, qmake 는 빌드용으로만 사용)
+CONFIG += c++11 console
+CONFIG -= app_bundle qt
+
+TARGET = mkbank
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../wavdecoder.cpp
+
+HEADERS += \
+    ../../samplebank.h \
+    ../../wavdecoder.h
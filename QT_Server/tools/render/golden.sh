@@ -0,0 +1,21 @@
+#!/bin/sh
+# 골든 출력 회귀 테스트: golden.txt 를 고정 블록 크기로 렌더해 PCM 해시를 비교한다.
+#
+# 사용법: golden.sh [render 실행 파일] [wav 폴더]
+#   기본값: ./render, 이 스크립트 기준 ../.. (QT_Server/*.wav)
+# qmake 빌드 폴더에서는 make check 가 이 스크립트를 부른다.
+
+here=$(cd "$(dirname "$0")" && pwd)
+render=${1:-./render}
+wavdir=${2:-$here/../..}
+fixture=$here/golden.txt
+
+block=$(sed -n 's/^# golden-block: *\([0-9]*\).*/\1/p' "$fixture")
+hash=$(sed -n 's/^# golden-hash: *\([0-9a-fA-F]*\).*/\1/p' "$fixture")
+if [ -z "$block" ] || [ -z "$hash" ]; then
+    echo "golden.sh: $fixture has no golden-block/golden-hash line" >&2
+    exit 2
+fi
+
+"$render" -w "$wavdir" -B "$block" -e "$hash" "$fixture" || { echo "golden: FAIL (block $block)" >&2; exit 1; }
+echo "golden: OK ($hash, block $block)"
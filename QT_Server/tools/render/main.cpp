@@ -0,0 +1,394 @@
+// 기록된 이벤트 목록 → 믹스된 WAV (실시간 재생 없이 CPU 가 허락하는 만큼 빠르게)
+//
+// 사용법: render [옵션] events.txt | journal-000.bandj [journal-001.bandj ...]
+//   -o out.wav   출력 WAV (없으면 렌더만 하고 처리량/해시만 출력 → 벤치마크)
+//   -b bank      샘플 뱅크 (기본 $QT_SERVER_SAMPLE_BANK 또는 ./samples.bank, tools/mkbank 로 생성)
+//   -w dir       뱅크 대신 <dir>/<이름>.wav 를 디코딩
+//   -B frames    렌더 블록 크기 (512). 믹서 설정 변경은 라이브처럼 블록 경계에서 반영된다
+//   -n repeat    같은 목록을 N 번 렌더 (처리량 측정용, WAV/해시는 첫 번째 것)
+//   -e hash      PCM 해시가 다르면 종료 코드 1 (골든 출력 비교)
+//
+// 이벤트 목록 (한 줄에 하나, '#' 뒤는 주석, 시각 순서가 아니어도 됨):
+//   <ms> <GUITA|DRUM|PIANO> <note> [velocity]    note = 번호 또는 텍스트 프로토콜 문자 (PIANO C, GUITA G)
+//   <ms> vol  <악기> <0~100>                     믹서 슬라이더와 같은 매핑 (samplemap.h)
+//   <ms> mute <악기> <0|1>                       뮤트 중인 채널의 노트는 라이브처럼 버린다
+//   <ms> pan  <악기> <-100~100>
+// 서버 이벤트 저널(.bandj, journalformat.h)을 주면 기록된 노트를 수신 시각 간격 그대로 렌더한다
+// (첫 이벤트 = 0 ms, 믹서 설정은 기본값. 필요하면 텍스트 목록으로 바꿔 vol/mute 줄을 더한다).
+//
+// 라이브 서버와 같은 MixerCore / 샘플 매핑 / 게인 매핑을 쓰고 노트는 delayFrames 로 샘플 단위 위치에 놓는다.
+// 같은 빌드라면 출력은 매번 비트 단위로 같으므로, 해시를 골든 값으로 두고 엔진 회귀를 잡을 수 있다.
+//
+// 예) ./render -b samples.bank -o take1.wav take1.txt
+//     ./render -b samples.bank -n 20 take1.txt            (초당 렌더 초)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "journalformat.h"
+#include "mixercore.h"
+#include "samplebank.h"
+#include "samplemap.h"
+#include "wavdecoder.h"
+
+namespace {
+
+const int kDefaultRate = 48000;
+
+struct Options {
+    std::vector<std::string> inputs;
+    std::string outPath;
+    std::string bankPath;
+    std::string wavDir;
+    int blockFrames = MixerCore::kBlockFrames;
+    int repeat = 1;
+    std::string expect;
+};
+
+enum EventKind { EV_NOTE, EV_VOL, EV_MUTE, EV_PAN };
+
+struct Event {
+    double ms = 0;
+    int    kind = EV_NOTE;
+    int    instrument = 0;
+    int    value = 0;       // note / volume / mute / pan
+    int    velocity = 0;
+    int    line = 0;        // 같은 시각이면 파일 순서 유지
+};
+
+// 출력 믹스 상태 (AudioEngine::ChannelState 와 같은 의미, 단일 스레드라 원자값 불필요)
+struct Channel {
+    int  volume = 100;
+    int  pan = 0;
+    bool mute = false;
+};
+
+struct Stats {
+    uint64_t notes = 0, muted = 0, missing = 0;
+    uint64_t frames = 0;
+    int      peak = 0;
+    uint64_t clipped = 0;
+    uint64_t hash = 1469598103934665603ULL;   // FNV-1a 64
+};
+
+int usage()
+{
+    std::fprintf(stderr, "usage: render [-o out.wav] [-b bank | -w wavdir] [-B frames] [-n repeat] [-e hash] events.txt | journal.bandj ...\n");
+    return 2;
+}
+
+int parseInstrument(const char *s)
+{
+    static const char *const kNames[BAND_INST_COUNT] = { "GUITA", "DRUM", "PIANO" };
+    for (int i = 0; i < BAND_INST_COUNT; ++i)
+        if (!strcasecmp(s, kNames[i])) return i;
+    char *end = nullptr;
+    const long v = std::strtol(s, &end, 10);
+    return (*s && !*end && v >= 0 && v < BAND_INST_COUNT) ? int(v) : -1;
+}
+
+int parseNote(int instrument, const char *s)
+{
+    char *end = nullptr;
+    const long v = std::strtol(s, &end, 10);
+    if (*s && !*end) return (v >= 0 && v < BAND_NOTE_COUNT[instrument]) ? int(v) : -1;
+    return s[0] && !s[1] ? band_note_from_char(uint8_t(instrument), s[0]) : -1;
+}
+
+bool loadEvents(const std::string &path, std::vector<Event> &out)
+{
+    FILE *f = std::fopen(path.c_str(), "r");
+    if (!f) { std::fprintf(stderr, "open fail: %s\n", path.c_str()); return false; }
+
+    char buf[256];
+    int lineNo = 0;
+    bool ok = true;
+    while (std::fgets(buf, sizeof(buf), f)) {
+        ++lineNo;
+        if (char *hash = std::strchr(buf, '#')) *hash = '\0';
+        char a[32] = {}, b[32] = {}, c[32] = {}, d[32] = {};
+        const int n = std::sscanf(buf, "%31s %31s %31s %31s", a, b, c, d);
+        if (n <= 0) continue;
+
+        Event ev;
+        ev.line = lineNo;
+        char *end = nullptr;
+        ev.ms = std::strtod(a, &end);
+        bool good = n >= 3 && *end == '\0' && ev.ms >= 0;
+        if (good && (!strcasecmp(b, "vol") || !strcasecmp(b, "mute") || !strcasecmp(b, "pan"))) {
+            ev.kind = !strcasecmp(b, "vol") ? EV_VOL : !strcasecmp(b, "mute") ? EV_MUTE : EV_PAN;
+            ev.instrument = parseInstrument(c);
+            ev.value = n >= 4 ? std::atoi(d) : 0;
+            good = n == 4 && ev.instrument >= 0;
+        } else if (good) {
+            ev.kind = EV_NOTE;
+            ev.instrument = parseInstrument(b);
+            ev.value = ev.instrument >= 0 ? parseNote(ev.instrument, c) : -1;
+            ev.velocity = n >= 4 ? std::atoi(d) : BAND_VELOCITY_DEFAULT;
+            good = ev.value >= 0 && ev.velocity >= 0 && ev.velocity <= BAND_VELOCITY_MAX;
+        }
+        if (!good) {
+            std::fprintf(stderr, "%s:%d: bad event\n", path.c_str(), lineNo);
+            ok = false;
+            continue;
+        }
+        out.push_back(ev);
+    }
+    std::fclose(f);
+    std::stable_sort(out.begin(), out.end(), [](const Event &x, const Event &y) { return x.ms < y.ms; });
+    return ok;
+}
+
+// 저널 세그먼트의 노트 레코드 → Event (ms 는 아직 절대 수신 시각, 호출한 쪽에서 0 기준으로 옮긴다)
+bool loadJournal(const std::string &path, std::vector<Event> &out)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        std::fprintf(stderr, "open fail: %s\n", path.c_str());
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    void *base = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    JournalView view;
+    std::string err;
+    const bool ok = base != MAP_FAILED && view.open(base, size_t(st.st_size), &err);
+    if (!ok) std::fprintf(stderr, "bad journal: %s (%s)\n", path.c_str(), base == MAP_FAILED ? "mmap" : err.c_str());
+    for (uint64_t i = 0; ok && i < view.count(); ++i) {
+        const JournalRecord &r = view.record(i);
+        Event ev;
+        ev.ms         = r.rxNs / 1e6;
+        ev.kind       = EV_NOTE;
+        ev.instrument = r.instrument < BAND_INST_COUNT ? r.instrument : 0;
+        ev.value      = r.note;
+        ev.velocity   = r.velocity;
+        out.push_back(ev);
+    }
+    if (base != MAP_FAILED) ::munmap(base, size_t(st.st_size));
+    return ok;
+}
+
+bool isJournal(const std::string &path)
+{
+    char magic[sizeof(kJournalMagic)] = {};
+    FILE *f = std::fopen(path.c_str(), "rb");
+    const bool yes = f && std::fread(magic, 1, sizeof(magic), f) == sizeof(magic)
+                     && std::memcmp(magic, kJournalMagic, sizeof(magic)) == 0;
+    if (f) std::fclose(f);
+    return yes;
+}
+
+// 샘플 뱅크는 라이브 서버처럼 읽기 전용 mmap 해서 복사 없이 참조한다 (매핑은 프로세스 끝까지 유지)
+bool openBank(const std::string &path, SampleBankView &view)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        std::fprintf(stderr, "bank open fail: %s\n", path.c_str());
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    void *base = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    std::string err;
+    if (base == MAP_FAILED || !view.open(base, size_t(st.st_size), &err)) {
+        std::fprintf(stderr, "bad sample bank: %s (%s)\n", path.c_str(), base == MAP_FAILED ? "mmap" : err.c_str());
+        return false;
+    }
+    return true;
+}
+
+void loadBank(const SampleBankView &view, MixerCore &core)
+{
+    for (int i = 0; i < SAMPLE_COUNT; ++i) {
+        const int idx = view.find(kSampleNames[i]);
+        if (idx < 0) { std::fprintf(stderr, "bank has no sample %s (muted)\n", kSampleNames[i]); continue; }
+        core.setSampleView(i, view.pcm(idx), view.frames(idx));
+    }
+}
+
+bool loadWavDir(const std::string &dir, MixerCore &core, int rate)
+{
+    for (int i = 0; i < SAMPLE_COUNT; ++i) {
+        const std::string path = dir + "/" + kSampleNames[i] + ".wav";
+        FILE *f = std::fopen(path.c_str(), "rb");
+        if (!f) { std::fprintf(stderr, "sample open fail: %s (muted)\n", path.c_str()); continue; }
+        std::vector<char> raw;
+        std::fseek(f, 0, SEEK_END);
+        const long n = std::ftell(f);
+        std::fseek(f, 0, SEEK_SET);
+        raw.resize(n > 0 ? size_t(n) : 0);
+        const bool readOk = n >= 0 && std::fread(raw.data(), 1, raw.size(), f) == raw.size();
+        std::fclose(f);
+
+        std::vector<int16_t> pcm;
+        std::string err;
+        if (!readOk || !decodeWavToStereo16(raw.data(), raw.size(), rate, pcm, &err)) {
+            std::fprintf(stderr, "decode fail: %s (%s)\n", path.c_str(), err.c_str());
+            return false;
+        }
+        core.setSample(i, std::move(pcm));
+    }
+    return true;
+}
+
+// 44바이트 PCM WAV 헤더 (서버 wav 싱크와 같은 makeWavHeader16)
+void writeWavHeader(FILE *f, int rate, uint32_t dataBytes)
+{
+    unsigned char h[kWavHeaderBytes];
+    makeWavHeader16(h, rate, dataBytes);
+    std::fwrite(h, sizeof(h), 1, f);
+}
+
+void applyChannels(MixerCore &core, const Channel *ch)
+{
+    for (int i = 0; i < BAND_INST_COUNT; ++i)
+        core.setChannel(i, ch[i].mute ? 0.f : mixerVolumeGain(ch[i].volume), ch[i].pan / 100.f);
+}
+
+// 이벤트 목록 전체 + 마지막 보이스가 끝날 때까지. out 이 있으면 블록마다 기록.
+void renderOnce(MixerCore &core, int rate, int blockFrames, const std::vector<Event> &events, FILE *out, Stats &st)
+{
+    Channel ch[BAND_INST_COUNT];
+    applyChannels(core, ch);
+    std::vector<int16_t> buf(size_t(blockFrames) * 2);
+    size_t next = 0;
+    uint64_t blockStart = 0;
+
+    while (next < events.size() || core.activeVoices() > 0) {
+        const uint64_t blockEnd = blockStart + uint64_t(blockFrames);
+        bool mixChanged = false;
+        for (; next < events.size(); ++next) {
+            const Event &ev = events[next];
+            const uint64_t frame = uint64_t(std::llround(ev.ms * rate / 1000.0));
+            if (frame >= blockEnd) break;
+            Channel &c = ch[ev.instrument];
+            switch (ev.kind) {
+            case EV_VOL:  c.volume = ev.value; mixChanged = true; break;
+            case EV_MUTE: c.mute = ev.value != 0; mixChanged = true; break;
+            case EV_PAN:  c.pan = std::max(-100, std::min(100, ev.value)); mixChanged = true; break;
+            default: {
+                ++st.notes;
+                if (c.mute) { ++st.muted; break; }
+                const int sample = sampleForNote(ev.instrument, ev.value);
+                const int delay = frame > blockStart ? int(frame - blockStart) : 0;
+                if (core.trigger(sample, velocityGain(ev.velocity), ev.instrument, delay) < 0) ++st.missing;
+                break;
+            }
+            }
+        }
+        if (mixChanged) applyChannels(core, ch);
+
+        core.render(buf.data(), blockFrames);
+        for (int16_t s : buf) {
+            const int a = s < 0 ? -int(s) : int(s);
+            if (a > st.peak) st.peak = a;
+            if (a >= 32767) ++st.clipped;
+        }
+        const unsigned char *p = reinterpret_cast<const unsigned char*>(buf.data());
+        for (size_t i = 0; i < buf.size() * sizeof(int16_t); ++i) {
+            st.hash ^= p[i];
+            st.hash *= 1099511628211ULL;
+        }
+        if (out) std::fwrite(buf.data(), sizeof(int16_t), buf.size(), out);
+        st.frames += uint64_t(blockFrames);
+        blockStart = blockEnd;
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options o;
+    if (const char *env = std::getenv("QT_SERVER_SAMPLE_BANK")) o.bankPath = env;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-o") && i + 1 < argc)      o.outPath = argv[++i];
+        else if (!std::strcmp(argv[i], "-b") && i + 1 < argc) o.bankPath = argv[++i];
+        else if (!std::strcmp(argv[i], "-w") && i + 1 < argc) o.wavDir = argv[++i];
+        else if (!std::strcmp(argv[i], "-B") && i + 1 < argc) o.blockFrames = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "-n") && i + 1 < argc) o.repeat = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "-e") && i + 1 < argc) o.expect = argv[++i];
+        else if (argv[i][0] == '-')                            return usage();
+        else                                                   o.inputs.push_back(argv[i]);
+    }
+    if (o.inputs.empty() || o.blockFrames <= 0 || o.repeat <= 0) return usage();
+    if (o.bankPath.empty() && o.wavDir.empty()) o.bankPath = "samples.bank";
+
+    std::vector<Event> events;
+    if (isJournal(o.inputs[0])) {
+        for (const std::string &path : o.inputs)
+            if (!loadJournal(path, events)) return 1;
+        std::stable_sort(events.begin(), events.end(), [](const Event &x, const Event &y) { return x.ms < y.ms; });
+        const double t0 = events.empty() ? 0 : events.front().ms;
+        for (Event &ev : events) ev.ms -= t0;
+    } else {
+        if (o.inputs.size() != 1) return usage();
+        if (!loadEvents(o.inputs[0], events)) return 1;
+    }
+
+    SampleBankView bank;
+    if (o.wavDir.empty() && !openBank(o.bankPath, bank)) return 1;
+    const int rate = bank.isOpen() ? int(bank.sampleRate()) : kDefaultRate;
+
+    // 샘플만 채운 원본. 패스마다 새 코어가 샘플을 참조해 보이스/버스 상태가 같은 초기값에서 시작하게 한다
+    MixerCore loaded(rate);
+    if (bank.isOpen()) loadBank(bank, loaded);
+    else if (!loadWavDir(o.wavDir, loaded, rate)) return 1;
+
+    FILE *out = nullptr;
+    if (!o.outPath.empty()) {
+        out = std::fopen(o.outPath.c_str(), "wb");
+        if (!out) { std::fprintf(stderr, "write fail: %s\n", o.outPath.c_str()); return 1; }
+        writeWavHeader(out, rate, 0);   // 길이는 끝나고 채운다
+    }
+
+    Stats first;
+    double mixSec = 0;
+    for (int r = 0; r < o.repeat; ++r) {
+        MixerCore core(rate);
+        core.shareSamples(loaded);
+        Stats st;
+        const auto t0 = std::chrono::steady_clock::now();
+        renderOnce(core, rate, o.blockFrames, events, r == 0 ? out : nullptr, st);
+        mixSec += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if (r == 0) first = st;
+        else if (st.hash != first.hash) std::fprintf(stderr, "warning: pass %d hash differs (non-deterministic mix)\n", r + 1);
+    }
+
+    if (out) {
+        const uint64_t bytes = first.frames * 4;
+        std::fseek(out, 0, SEEK_SET);
+        writeWavHeader(out, rate, bytes > 0xFFFFFFFFULL ? 0xFFFFFFFFU : uint32_t(bytes));
+        if (std::fclose(out) != 0) { std::fprintf(stderr, "write fail: %s\n", o.outPath.c_str()); return 1; }
+    }
+
+    const double audioSec = double(first.frames) / rate * o.repeat;
+    std::printf("events     : %zu (notes %llu, muted %llu, no sample %llu)\n", events.size(),
+                (unsigned long long)first.notes, (unsigned long long)first.muted, (unsigned long long)first.missing);
+    std::printf("audio      : %.3f s, %d Hz stereo, block %d, peak %.1f dBFS, clipped %llu\n",
+                double(first.frames) / rate, rate, o.blockFrames,
+                first.peak ? 20.0 * std::log10(first.peak / 32767.0) : -INFINITY, (unsigned long long)first.clipped);
+    std::printf("throughput : %.3f s rendered in %.3f s wall -> %.1f x realtime (%d pass%s)\n",
+                audioSec, mixSec, mixSec > 0 ? audioSec / mixSec : 0.0, o.repeat, o.repeat > 1 ? "es" : "");
+    std::printf("pcm hash   : %016llx\n", (unsigned long long)first.hash);
+    if (!o.outPath.empty()) std::printf("wrote      : %s\n", o.outPath.c_str());
+
+    if (!o.expect.empty() && std::strtoull(o.expect.c_str(), nullptr, 16) != first.hash) {
+        std::fprintf(stderr, "hash mismatch: expected %s\n", o.expect.c_str());
+        return 1;
+    }
+    return 0;
+}
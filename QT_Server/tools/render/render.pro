@@ -0,0 +1,29 @@
+# 오프라인 렌더러: 이벤트 목록 → WAV (Qt 라이브러리 비의존, qmake 는 빌드용으로만 사용)
+CONFIG += c++11 console
+CONFIG -= app_bundle qt
+
+TARGET = render
+
+INCLUDEPATH += ../.. ../../../common
+
+SOURCES += \
+    main.cpp \
+    ../../mixercore.cpp \
+    ../../wavdecoder.cpp
+
+HEADERS += \
+    ../../../common/band_protocol.h \
+    ../../journalformat.h \
+    ../../mixercore.h \
+    ../../samplebank.h \
+    ../../samplemap.h \
+    ../../wavdecoder.h
+
+# make check: 골든 출력 회귀 테스트 (golden.txt 를 고정 블록 크기로 렌더해 해시 비교)
+check.commands = sh $$PWD/golden.sh ./$$TARGET $$PWD/../..
+check.depends = $$TARGET
+QMAKE_EXTRA_TARGETS += check
+
+OTHER_FILES += \
+    golden.sh \
+    golden.txt
@@ -0,0 +1,293 @@
+// 이벤트 저널(.bandj) → 실행 중인 서버로 다시 재생
+//
+// 사용법: replay [옵션] journal-000.bandj [journal-001.bandj ...]
+//   -H host      서버 주소 (127.0.0.1)
+//   -p port      포트 (5000)
+//   -a file      id/pw 목록 (QT_Server/idpasswd.txt 형식, 기본 ./idpasswd.txt). 저널의 클라이언트 ID 로 로그인
+//   -x speed     재생 속도 배율 (1 = 원래 타이밍, 2 = 두 배 빠르게, 0 = 쉬지 않고 최대한 빠르게)
+//   -m mode      orig | text | bin | udp  (기본 orig: 클라이언트마다 기록된 전송 방식 그대로)
+//   -r repeat    저널 전체를 N 번 반복 (부하 테스트용)
+//
+// 세그먼트 여러 개를 주면 이어 붙여 수신 시각 순으로 재생한다. 클라이언트 ID 마다 연결 하나를 열고,
+// 이벤트 사이 간격은 서버가 기록한 수신 시각 차이 / speed. BIN/UDP 레코드의 클라이언트 시각은
+// 재생 시점의 시각으로 새로 찍는다 (서버 지터 버퍼는 재생 도구의 송신 간격을 보게 된다).
+//
+// 예) ./replay -a QT_Server/idpasswd.txt journal/20261016-201500-000.bandj
+//     ./replay -a QT_Server/idpasswd.txt -x 0 -r 10 take.bandj      (실제 세션을 부하 테스트로)
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "band_protocol.h"
+#include "band_session.h"
+#include "band_udp.h"
+#include "journalformat.h"
+
+namespace {
+
+enum Mode { MODE_ORIG = -1, MODE_TEXT = JOURNAL_TEXT, MODE_BIN = JOURNAL_BIN, MODE_UDP = JOURNAL_UDP };
+
+struct Options {
+    std::string host = "127.0.0.1";
+    int port = 5000;
+    std::string idFile = "idpasswd.txt";
+    double speed = 1.0;
+    int mode = MODE_ORIG;
+    int repeat = 1;
+    std::vector<std::string> inputs;
+};
+
+struct Conn {
+    std::string id;
+    int         fd = -1;
+    int         mode = MODE_TEXT;
+    uint32_t    seq = 0;
+    BandUdpLink udp;
+    uint64_t    sent = 0;
+};
+
+int usage()
+{
+    std::fprintf(stderr, "usage: replay [-H host] [-p port] [-a idfile] [-x speed] [-m orig|text|bin|udp] [-r repeat] "
+                         "journal.bandj ...\n");
+    return 2;
+}
+
+bool loadJournal(const std::string &path, std::vector<JournalRecord> &out)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        std::fprintf(stderr, "open fail: %s\n", path.c_str());
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    void *base = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    JournalView view;
+    std::string err;
+    if (base == MAP_FAILED || !view.open(base, size_t(st.st_size), &err)) {
+        std::fprintf(stderr, "bad journal: %s (%s)\n", path.c_str(), base == MAP_FAILED ? "mmap" : err.c_str());
+        if (base != MAP_FAILED) ::munmap(base, size_t(st.st_size));
+        return false;
+    }
+    // JournalView 는 헤더만 검사한다. 잘리거나 깨진 레코드는 band_read_event 처럼 범위 검사로 건너뛴다
+    uint64_t skipped = 0;
+    for (uint64_t i = 0; i < view.count(); ++i) {
+        const JournalRecord &r = view.record(i);
+        if (r.instrument >= BAND_INST_COUNT || r.note >= BAND_NOTE_COUNT[r.instrument]) { ++skipped; continue; }
+        out.push_back(r);
+    }
+    std::fprintf(stderr, "%s: segment %u, %llu records", path.c_str(), view.header().segment,
+                 (unsigned long long)view.count());
+    if (skipped) std::fprintf(stderr, " (%llu out of range, skipped)", (unsigned long long)skipped);
+    std::fprintf(stderr, "\n");
+    ::munmap(base, size_t(st.st_size));
+    return true;
+}
+
+std::map<std::string, std::string> loadCreds(const std::string &path)
+{
+    std::map<std::string, std::string> out;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream ss(line);
+        std::string id, pw;
+        if (!(ss >> id >> pw) || id[0] == '#') continue;
+        out[id] = pw;
+    }
+    return out;
+}
+
+bool sendAll(int fd, const void *data, size_t len)
+{
+    const char *p = static_cast<const char*>(data);
+    while (len > 0) {
+        const ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0) { if (errno == EINTR) continue; return false; }
+        p += n;
+        len -= size_t(n);
+    }
+    return true;
+}
+
+// 로그인 후 세션 토큰 줄로 성공 확인, 모드 협상까지
+bool openConn(const Options &o, Conn &c, const std::string &pw)
+{
+    c.fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (c.fd < 0) { std::perror("socket"); return false; }
+    int one = 1;
+    ::setsockopt(c.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(uint16_t(o.port));
+    if (::inet_pton(AF_INET, o.host.c_str(), &addr.sin_addr) != 1 ||
+        ::connect(c.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::perror("connect");
+        return false;
+    }
+    const std::string login = c.id + ":" + pw + "\n";
+    std::string token;
+    if (!sendAll(c.fd, login.data(), login.size()) || !band_session_wait(c.fd, token, 2000)) {
+        std::fprintf(stderr, "[%s] login failed (no session reply)\n", c.id.c_str());
+        return false;
+    }
+    if (c.mode == MODE_UDP && !band_udp_open(c.fd, o.host, c.udp)) {
+        std::fprintf(stderr, "[%s] udp unavailable -> bin over tcp\n", c.id.c_str());
+        c.mode = MODE_BIN;
+    }
+    if (c.mode == MODE_BIN && !sendAll(c.fd, BAND_PROTO_HELLO_BIN, std::strlen(BAND_PROTO_HELLO_BIN)))
+        return false;
+    return true;
+}
+
+bool sendEvent(Conn &c, const JournalRecord &r)
+{
+    if (c.mode == MODE_UDP) return band_udp_send(c.udp, r.instrument, r.note, r.velocity);
+    if (c.mode == MODE_BIN) {
+        const BandEventRecord rec = band_make_event(r.instrument, r.note, r.velocity, ++c.seq, band_now_us());
+        return sendAll(c.fd, &rec, sizeof(rec));
+    }
+    static const char *const kTags[BAND_INST_COUNT] = { "[GUITA]", "[DRUM]", "[PIANO]" };
+    static const char GUITA[] = "GDC";
+    static const char PIANO[] = "CDEFGAB";
+    std::string line = kTags[r.instrument];
+    switch (r.instrument) {
+    case BAND_INST_GUITA: line += GUITA[r.note]; break;
+    case BAND_INST_PIANO: line += PIANO[r.note]; break;
+    default:                                   // 드럼만 텍스트에 속도를 붙일 수 있다 ("[DRUM]3,96")
+        line += std::to_string(int(r.note));
+        if (r.velocity) line += ',' + std::to_string(int(r.velocity));
+        break;
+    }
+    line += '\n';
+    return sendAll(c.fd, line.data(), line.size());
+}
+
+// 서버가 보내는 줄(PROTO OK, PONG 등)은 읽어서 버린다 (수신 버퍼가 차서 서버가 막히지 않게)
+void drain(const Conn &c)
+{
+    char buf[512];
+    while (::recv(c.fd, buf, sizeof(buf), MSG_DONTWAIT) > 0) {}
+}
+
+uint32_t pct(std::vector<uint32_t> v, double p)
+{
+    if (v.empty()) return 0;
+    const size_t k = std::min(v.size() - 1, size_t(p / 100.0 * double(v.size())));
+    std::nth_element(v.begin(), v.begin() + long(k), v.end());
+    return v[k];
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (a.size() == 2 && a[0] == '-' && !v) return usage();
+        if (a == "-H")      { o.host = v; ++i; }
+        else if (a == "-p") { o.port = std::atoi(v); ++i; }
+        else if (a == "-a") { o.idFile = v; ++i; }
+        else if (a == "-x") { o.speed = std::atof(v); ++i; }
+        else if (a == "-r") { o.repeat = std::atoi(v); ++i; }
+        else if (a == "-m") {
+            const std::string m = v; ++i;
+            if (m == "orig")      o.mode = MODE_ORIG;
+            else if (m == "text") o.mode = MODE_TEXT;
+            else if (m == "bin")  o.mode = MODE_BIN;
+            else if (m == "udp")  o.mode = MODE_UDP;
+            else return usage();
+        }
+        else if (a[0] == '-') return usage();
+        else o.inputs.push_back(a);
+    }
+    if (o.inputs.empty() || o.speed < 0 || o.repeat <= 0) return usage();
+
+    std::vector<JournalRecord> recs;
+    for (const std::string &path : o.inputs)
+        if (!loadJournal(path, recs)) return 1;
+    if (recs.empty()) { std::fprintf(stderr, "no records\n"); return 1; }
+    std::stable_sort(recs.begin(), recs.end(),
+                     [](const JournalRecord &x, const JournalRecord &y) { return x.rxNs < y.rxNs; });
+
+    // 클라이언트 ID 마다 연결 하나. orig 모드면 그 ID 의 첫 레코드 전송 방식을 따른다
+    const std::map<std::string, std::string> creds = loadCreds(o.idFile);
+    std::map<std::string, Conn> conns;
+    for (const JournalRecord &r : recs) {
+        const std::string id = journalClientId(r);
+        if (conns.count(id)) continue;
+        Conn &c = conns[id];
+        c.id = id;
+        c.mode = (o.mode == MODE_ORIG) ? (r.transport <= JOURNAL_UDP ? int(r.transport) : MODE_TEXT) : o.mode;
+        const auto cred = creds.find(id);
+        if (cred == creds.end()) { std::fprintf(stderr, "no password for '%s' in %s\n", id.c_str(), o.idFile.c_str()); return 1; }
+        if (!openConn(o, c, cred->second)) return 1;
+        static const char *const kModeNames[] = { "text", "bin", "udp" };
+        std::fprintf(stderr, "[%s] connected (%s)\n", id.c_str(), kModeNames[c.mode]);
+    }
+
+    const int64_t span = recs.back().rxNs - recs.front().rxNs;
+    char speed[32] = "max";
+    if (o.speed > 0) std::snprintf(speed, sizeof(speed), "%g", o.speed);
+    std::printf("replaying %zu events from %zu clients, %.3f s recorded, speed %s, x%d\n",
+                recs.size(), conns.size(), span / 1e9, speed, o.repeat);
+
+    using Clock = std::chrono::steady_clock;
+    std::vector<uint32_t> lagUs;
+    lagUs.reserve(recs.size() * size_t(o.repeat));
+    uint64_t sent = 0, failed = 0;
+    const auto wall0 = Clock::now();
+    for (int pass = 0; pass < o.repeat; ++pass) {
+        const auto t0 = Clock::now() + std::chrono::milliseconds(100);
+        const int64_t rx0 = recs.front().rxNs;
+        for (size_t i = 0; i < recs.size(); ++i) {
+            const JournalRecord &r = recs[i];
+            auto due = Clock::now();
+            if (o.speed > 0) {
+                due = t0 + std::chrono::nanoseconds(int64_t(double(r.rxNs - rx0) / o.speed));
+                std::this_thread::sleep_until(due);
+            }
+            Conn &c = conns[journalClientId(r)];
+            if (sendEvent(c, r)) { ++sent; ++c.sent; } else ++failed;
+            if (o.speed > 0)
+                lagUs.push_back(uint32_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - due).count()));
+            if ((i & 63) == 0) for (auto &kv : conns) drain(kv.second);
+        }
+    }
+    const double wallSec = std::chrono::duration<double>(Clock::now() - wall0).count();
+
+    for (auto &kv : conns) {
+        std::printf("  %-16s %8llu sent\n", kv.first.c_str(), (unsigned long long)kv.second.sent);
+        band_udp_close(kv.second.udp);
+        ::close(kv.second.fd);
+    }
+    std::printf("sent %llu (failed %llu) in %.3f s -> %.0f events/s\n", (unsigned long long)sent,
+                (unsigned long long)failed, wallSec, wallSec > 0 ? sent / wallSec : 0.0);
+    if (!lagUs.empty())
+        std::printf("send lag vs schedule (us): p50 %u  p99 %u  max %u\n",
+                    pct(lagUs, 50), pct(lagUs, 99), *std::max_element(lagUs.begin(), lagUs.end()));
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,16 @@
+# 이벤트 저널 재생기 (Qt 라이브러리 비의존, POSIX 소켓)
+CONFIG += c++11 console
+CONFIG -= app_bundle qt
+
+TARGET = replay
+
+INCLUDEPATH += ../.. ../../../common
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../../../common/band_protocol.h \
+    ../../../common/band_session.h \
+    ../../../common/band_udp.h \
+    ../../journalformat.h
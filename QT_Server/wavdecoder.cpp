@@ -0,0 +1,113 @@
+#include "wavdecoder.h"
+
+#include <cstring>
+
+static inline uint32_t rd32(const unsigned char *p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+static inline uint16_t rd16(const unsigned char *p) {
+    return uint16_t(p[0] | (p[1] << 8));
+}
+
+static inline void wr32(unsigned char *p, uint32_t v) {
+    p[0] = uint8_t(v); p[1] = uint8_t(v >> 8); p[2] = uint8_t(v >> 16); p[3] = uint8_t(v >> 24);
+}
+static inline void wr16(unsigned char *p, uint16_t v) {
+    p[0] = uint8_t(v); p[1] = uint8_t(v >> 8);
+}
+
+static bool fail(std::string *err, const char *msg) {
+    if (err) *err = msg;
+    return false;
+}
+
+bool decodeWavToStereo16(const char *data, size_t size, int outRate,
+                         std::vector<int16_t> &outPcm, std::string *err)
+{
+    const unsigned char *p = reinterpret_cast<const unsigned char*>(data);
+    if (size < 12 || std::memcmp(p, "RIFF", 4) != 0 || std::memcmp(p + 8, "WAVE", 4) != 0)
+        return fail(err, "not a RIFF/WAVE file");
+
+    int fmtTag = 0, channels = 0, rate = 0, bits = 0;
+    const unsigned char *pcm = nullptr;
+    size_t pcmBytes = 0;
+
+    // 청크 순회: fmt / data 만 사용 (LIST 등은 건너뜀)
+    size_t off = 12;
+    while (off + 8 <= size) {
+        const unsigned char *ck = p + off;
+        size_t ckSize = rd32(ck + 4);
+        size_t body = off + 8;
+        if (ckSize > size - body) ckSize = size - body;   // 잘린 파일 허용
+
+        if (std::memcmp(ck, "fmt ", 4) == 0 && ckSize >= 16) {
+            fmtTag   = rd16(ck + 8);
+            channels = rd16(ck + 10);
+            rate     = int(rd32(ck + 12));
+            bits     = rd16(ck + 22);
+        } else if (std::memcmp(ck, "data", 4) == 0) {
+            pcm = ck + 8;
+            pcmBytes = ckSize;
+        }
+        off = body + ckSize + (ckSize & 1);
+    }
+
+    if (fmtTag != 1 || bits != 16) return fail(err, "only PCM 16bit is supported");
+    if (channels != 1 && channels != 2) return fail(err, "only mono/stereo is supported");
+    if (rate <= 0 || outRate <= 0)      return fail(err, "invalid sample rate");
+    if (!pcm)                           return fail(err, "missing data chunk");
+
+    const size_t inFrames = pcmBytes / size_t(2 * channels);
+    if (inFrames == 0) { outPcm.clear(); return true; }
+
+    // 입력 프레임 하나를 스테레오로 읽는다
+    auto frameAt = [&](size_t i, int &l, int &r) {
+        const unsigned char *s = pcm + i * size_t(2 * channels);
+        l = int16_t(rd16(s));
+        r = (channels == 2) ? int16_t(rd16(s + 2)) : l;
+    };
+
+    if (rate == outRate) {
+        outPcm.resize(inFrames * 2);
+        for (size_t i = 0; i < inFrames; ++i) {
+            int l, r; frameAt(i, l, r);
+            outPcm[2*i]   = int16_t(l);
+            outPcm[2*i+1] = int16_t(r);
+        }
+        return true;
+    }
+
+    // 선형 보간 리샘플 (44.1k → 48k 등). 오프라인 1회 변환이라 품질보다 단순함 우선.
+    const size_t outFrames = size_t((uint64_t(inFrames) * uint64_t(outRate)) / uint64_t(rate));
+    outPcm.resize(outFrames * 2);
+    const double step = double(rate) / double(outRate);
+    for (size_t o = 0; o < outFrames; ++o) {
+        const double pos = o * step;
+        size_t i0 = size_t(pos);
+        if (i0 >= inFrames) i0 = inFrames - 1;
+        const size_t i1 = (i0 + 1 < inFrames) ? i0 + 1 : i0;
+        const double t = pos - double(i0);
+        int l0, r0, l1, r1;
+        frameAt(i0, l0, r0);
+        frameAt(i1, l1, r1);
+        outPcm[2*o]   = int16_t(l0 + (l1 - l0) * t);
+        outPcm[2*o+1] = int16_t(r0 + (r1 - r0) * t);
+    }
+    return true;
+}
+
+void makeWavHeader16(unsigned char out[kWavHeaderBytes], int rate, uint32_t dataBytes)
+{
+    const uint32_t maxData = 0xFFFFFFFFu - 36;   // RIFF 크기 필드가 넘치지 않게
+    if (dataBytes > maxData) dataBytes = maxData;
+    std::memcpy(out, "RIFF", 4);      wr32(out + 4, 36 + dataBytes);
+    std::memcpy(out + 8, "WAVE", 4);
+    std::memcpy(out + 12, "fmt ", 4); wr32(out + 16, 16);
+    wr16(out + 20, 1);                // PCM
+    wr16(out + 22, 2);                // 스테레오
+    wr32(out + 24, uint32_t(rate));
+    wr32(out + 28, uint32_t(rate) * 4);
+    wr16(out + 32, 4);                // block align
+    wr16(out + 34, 16);               // bits
+    std::memcpy(out + 36, "data", 4); wr32(out + 40, dataBytes);
+}
@@ -0,0 +1,20 @@
+#ifndef WAVDECODER_H
+#define WAVDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// RIFF/WAVE(PCM 16bit, mono/stereo) 디코더.
+// 엔진 출력 포맷(스테레오 interleaved int16, outRate Hz)으로 한 번에 변환한다.
+// 모노는 양쪽 채널로 복제하고, 샘플레이트가 다르면 선형 보간으로 리샘플한다.
+bool decodeWavToStereo16(const char *data, size_t size, int outRate,
+                         std::vector<int16_t> &outPcm, std::string *err = nullptr);
+
+// 엔진 출력 포맷(스테레오 int16, rate Hz) 44바이트 PCM 헤더.
+// 스트리밍으로 쓸 때는 dataBytes = 0 으로 먼저 쓰고 끝난 뒤 실제 길이로 다시 쓴다.
+static const int kWavHeaderBytes = 44;
+void makeWavHeader16(unsigned char out[kWavHeaderBytes], int rate, uint32_t dataBytes);
+
+#endif // WAVDECODER_H
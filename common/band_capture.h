@@ -0,0 +1,213 @@
+#ifndef BAND_CAPTURE_H
+#define BAND_CAPTURE_H
+
+// 클라이언트용 고속 카메라 캡처 모드 (header-only, Linux V4L2 + OpenCV, 서버는 쓰지 않음)
+//   BAND_CAPTURE=fast 이면 장치가 광고하는 (포맷, 크기, 프레임 간격) 중 프레임 수가 가장 높은 조합을 골라
+//   V4L2 백엔드로 연다 (예: MJPG 640x360 @120). 실제로 잡힌 포맷은 다시 읽어 [CAM] 줄로 출력한다.
+//   BAND_CAPTURE_MAXW 로 고를 최대 폭을 제한한다 (기본 1280).
+//
+// 프레임 시각: read() 직후 band_capture_frame_us(cap, band_now_us()) 로 드라이버 버퍼 시각을 얻는다.
+//   V4L2 버퍼 timestamp 는 CLOCK_MONOTONIC (= steady_clock, band_now_us 와 같은 축) 이고, UVC 는 첫 패킷 수신 시각이다.
+//   그래서 "read() 가 돌아온 시각"이 아니라 촬상 직후부터 지연을 잴 수 있다 (read 대기/디코드/큐 지연 포함).
+//   값이 없거나 다른 시계면 read 시각으로 대신한다.
+
+#include "band_protocol.h"
+
+#include <opencv2/videoio.hpp>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+struct BandCaptureFormat {
+    uint32_t fourcc = 0;     // V4L2 / OpenCV 공통 FOURCC (MJPG, YUYV)
+    int      width  = 0;
+    int      height = 0;
+    double   fps    = 0;
+};
+
+static inline bool band_fast_capture_requested()
+{
+    const char *v = std::getenv("BAND_CAPTURE");
+    return v && std::strcmp(v, "fast") == 0;
+}
+
+static inline std::string band_fourcc_str(uint32_t fourcc)
+{
+    std::string s(4, ' ');
+    for (int i = 0; i < 4; ++i) {
+        const char ch = char((fourcc >> (8 * i)) & 0xff);
+        s[i] = (ch >= 32 && ch < 127) ? ch : '?';
+    }
+    return s;
+}
+
+static inline int band_v4l2_ioctl(int fd, unsigned long req, void *arg)
+{
+    int r;
+    do { r = ::ioctl(fd, req, arg); } while (r < 0 && errno == EINTR);
+    return r;
+}
+
+// 한 후보를 지금까지의 최선과 비교: fps 가 높을수록, 같으면 작은 크기(디코드/전송 부담), 같으면 MJPG
+static inline void band_capture_consider(BandCaptureFormat &best, uint32_t fourcc, int w, int h,
+                                         const v4l2_fract &interval)
+{
+    if (interval.numerator == 0 || interval.denominator == 0) return;
+    const double fps = double(interval.denominator) / interval.numerator;
+    const bool better = fps > best.fps + 0.5
+        || (fps > best.fps - 0.5 && (w * h < best.width * best.height
+        || (w * h == best.width * best.height && fourcc == V4L2_PIX_FMT_MJPEG && best.fourcc != V4L2_PIX_FMT_MJPEG)));
+    if (!best.fourcc || better) {
+        best.fourcc = fourcc;
+        best.width  = w;
+        best.height = h;
+        best.fps    = fps;
+    }
+}
+
+// 연속/단계 크기 범위에서 want 폭에 가장 가까운 허용 크기 (폭은 min_width + k*step_width 격자).
+// roundUp 이면 want 이상, 아니면 want 이하 쪽으로 맞춘다. 높이는 최대 크기의 비율로 따라가며 높이 격자에 맞춘다.
+// 범위 안에 그런 폭이 없으면 false
+static inline bool band_capture_step_size(const v4l2_frmsize_stepwise &sw, int want, bool roundUp, int &w, int &h)
+{
+    const int64_t minW = sw.min_width, maxW = sw.max_width, minH = sw.min_height, maxH = sw.max_height;
+    const int64_t stepW = sw.step_width ? sw.step_width : 1, stepH = sw.step_height ? sw.step_height : 1;
+    if (maxW < minW || maxH < minH || maxW <= 0) return false;
+
+    const int64_t lastW = minW + (maxW - minW) / stepW * stepW;   // 격자 위의 가장 큰 폭
+    int64_t x = want;
+    if (x < minW) x = minW;
+    if (x > lastW) x = lastW;
+    const int64_t k = (x - minW) / stepW;
+    x = minW + k * stepW;
+    if (roundUp && x < want) x += stepW;
+    if (x > lastW || (roundUp ? x < want : x > want)) return false;
+
+    int64_t y = x * maxH / maxW;
+    if (y < minH) y = minH;
+    y = minH + (y - minH + stepH / 2) / stepH * stepH;
+    if (y > maxH) y = minH + (maxH - minH) / stepH * stepH;
+
+    w = int(x);
+    h = int(y);
+    return true;
+}
+
+// dev 의 MJPG/YUYV 모드 중 minWidth <= 폭 <= maxWidth 에서 가장 빠른 것
+static inline bool band_capture_best_format(const std::string &dev, BandCaptureFormat &out, int minWidth, int maxWidth)
+{
+    const int fd = ::open(dev.c_str(), O_RDWR | O_NONBLOCK);
+    if (fd < 0) return false;
+
+    BandCaptureFormat best;
+    v4l2_fmtdesc fmt;
+    std::memset(&fmt, 0, sizeof(fmt));
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    for (; band_v4l2_ioctl(fd, VIDIOC_ENUM_FMT, &fmt) == 0; ++fmt.index) {
+        if (fmt.pixelformat != V4L2_PIX_FMT_MJPEG && fmt.pixelformat != V4L2_PIX_FMT_YUYV) continue;
+
+        v4l2_frmsizeenum size;
+        std::memset(&size, 0, sizeof(size));
+        size.pixel_format = fmt.pixelformat;
+        for (; band_v4l2_ioctl(fd, VIDIOC_ENUM_FRAMESIZES, &size) == 0; ++size.index) {
+            // 연속/단계 크기는 요청 범위로 잘라 양 끝 (minWidth 이상 가장 작은 폭, maxWidth 이하 가장 큰 폭) 만 본다
+            int sizes[2][2] = {};
+            int nSizes = 0;
+            if (size.type == V4L2_FRMSIZE_TYPE_DISCRETE) {
+                sizes[0][0] = int(size.discrete.width);
+                sizes[0][1] = int(size.discrete.height);
+                nSizes = 1;
+            } else {
+                if (band_capture_step_size(size.stepwise, minWidth, true, sizes[nSizes][0], sizes[nSizes][1])) ++nSizes;
+                if (band_capture_step_size(size.stepwise, maxWidth, false, sizes[nSizes][0], sizes[nSizes][1])
+                    && (nSizes == 0 || sizes[1][0] != sizes[0][0])) ++nSizes;
+            }
+            for (int s = 0; s < nSizes; ++s) {
+                const int w = sizes[s][0], h = sizes[s][1];
+                if (w < minWidth || w > maxWidth) continue;
+
+                v4l2_frmivalenum ival;
+                std::memset(&ival, 0, sizeof(ival));
+                ival.pixel_format = fmt.pixelformat;
+                ival.width  = uint32_t(w);
+                ival.height = uint32_t(h);
+                for (; band_v4l2_ioctl(fd, VIDIOC_ENUM_FRAMEINTERVALS, &ival) == 0; ++ival.index) {
+                    if (ival.type == V4L2_FRMIVAL_TYPE_DISCRETE) {
+                        band_capture_consider(best, fmt.pixelformat, w, h, ival.discrete);
+                    } else {
+                        band_capture_consider(best, fmt.pixelformat, w, h, ival.stepwise.min);   // 최소 간격 = 최고 fps
+                        break;
+                    }
+                }
+            }
+            if (size.type != V4L2_FRMSIZE_TYPE_DISCRETE) break;
+        }
+    }
+    ::close(fd);
+    if (!best.fourcc) return false;
+    out = best;
+    return true;
+}
+
+// 지금 cap 에 실제로 잡힌 포맷
+static inline BandCaptureFormat band_capture_negotiated(cv::VideoCapture &cap)
+{
+    BandCaptureFormat f;
+    f.fourcc = uint32_t(cap.get(cv::CAP_PROP_FOURCC));
+    f.width  = int(cap.get(cv::CAP_PROP_FRAME_WIDTH));
+    f.height = int(cap.get(cv::CAP_PROP_FRAME_HEIGHT));
+    f.fps    = cap.get(cv::CAP_PROP_FPS);
+    return f;
+}
+
+// 고속 모드로 dev 를 연다. 고를 포맷이 없거나 열기 실패면 false (cap 은 닫힌 상태, 호출한 쪽이 기존 방식으로 연다)
+static inline bool band_capture_open_fast(cv::VideoCapture &cap, const std::string &dev, BandCaptureFormat &got,
+                                          int minWidth = 320)
+{
+    int maxWidth = 1280;
+    if (const char *m = std::getenv("BAND_CAPTURE_MAXW")) maxWidth = std::atoi(m) > 0 ? std::atoi(m) : maxWidth;
+
+    BandCaptureFormat want;
+    if (!band_capture_best_format(dev, want, minWidth, maxWidth)) {
+        fprintf(stderr, "[CAM] fast capture: no MJPG/YUYV mode %d~%dpx wide on %s\n", minWidth, maxWidth, dev.c_str());
+        return false;
+    }
+    if (!cap.open(dev, cv::CAP_V4L2)) {
+        fprintf(stderr, "[CAM] fast capture: cannot open %s\n", dev.c_str());
+        return false;
+    }
+    // FOURCC → 크기 → fps 순서 (크기/포맷을 바꾸면 드라이버가 fps 를 다시 고르는 경우가 있다)
+    cap.set(cv::CAP_PROP_FOURCC, double(want.fourcc));
+    cap.set(cv::CAP_PROP_FRAME_WIDTH, want.width);
+    cap.set(cv::CAP_PROP_FRAME_HEIGHT, want.height);
+    cap.set(cv::CAP_PROP_FPS, want.fps);
+    cap.set(cv::CAP_PROP_BUFFERSIZE, 2);   // 드라이버 큐에 오래된 프레임이 쌓이지 않게
+
+    got = band_capture_negotiated(cap);
+    fprintf(stderr, "[CAM] fast capture %s: want %s %dx%d@%.0f -> got %s %dx%d@%.1f\n", dev.c_str(),
+            band_fourcc_str(want.fourcc).c_str(), want.width, want.height, want.fps,
+            band_fourcc_str(got.fourcc).c_str(), got.width, got.height, got.fps);
+    return true;
+}
+
+// 마지막 read()/grab() 프레임의 드라이버 시각 (band_now_us 축, us). readUs = read() 가 돌아온 직후의 band_now_us().
+// 드라이버 시각이 없거나 다른 시계(미래이거나 1초 넘게 과거)면 readUs. fromDriver 로 어느 쪽인지 알려 준다.
+static inline uint64_t band_capture_frame_us(cv::VideoCapture &cap, uint64_t readUs, bool *fromDriver = nullptr)
+{
+    const double ms = cap.get(cv::CAP_PROP_POS_MSEC);   // V4L2 백엔드: 버퍼 timestamp
+    const uint64_t us = ms > 0 ? uint64_t(ms * 1000.0) : 0;
+    const bool ok = us && us <= readUs && readUs - us < 1000000;
+    if (fromDriver) *fromDriver = ok;
+    return ok ? us : readUs;
+}
+
+#endif // BAND_CAPTURE_H
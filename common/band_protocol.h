@@ -0,0 +1,158 @@
+#ifndef BAND_PROTOCOL_H
+#define BAND_PROTOCOL_H
+
+// Remote Band 공용 와이어 프로토콜 정의 (header-only, C++11, Qt/OpenCV 비의존)
+// QT_Server 와 세 악기 클라이언트(guita / drum / piano)가 같이 include 한다.
+//
+// 1) 텍스트 프로토콜 (기존, 계속 지원)
+//      로그인  "ID:PW\n"
+//      이벤트  "[DRUM]3\n", "[PIANO]C\n", "[GUITA]G\n"
+//              드럼은 속도를 붙일 수 있다 "[DRUM]3,96\n" (1~127, 없으면 기본 세기)
+//
+// 2) 바이너리 프로토콜 (협상)
+//      로그인 후 텍스트 한 줄 BAND_PROTO_HELLO_BIN 을 보내면, 서버는 그 줄 바로 다음
+//      바이트부터 해당 연결을 고정 길이 BandEventRecord 스트림으로 해석한다.
+//      (서버 응답 "PROTO BIN1 OK\n" 은 확인용이며 기다리지 않아도 된다)
+//      서버 파싱 = 길이 확인 + memcpy + 범위 확인.
+//
+// 3) UDP 이벤트 전송 (선택, band_udp.h)
+//      로그인/제어는 TCP 그대로. 로그인 후 BAND_PROTO_HELLO_UDP 를 보내면 서버가
+//      "UDP1 <port> <key(hex)>\n" 으로 답하고, 이후 노트는 BandUdpDatagram 으로 보낸다.
+//      서버는 key + 송신 IP 로 클라이언트를 찾고, seq 로 중복/늦은 역순 패킷을 버린다.
+//
+// 4) 세션 재개 (선택, band_session.h)
+//      로그인 성공 시 서버가 "SESSION <token(hex)>\n" 을 보낸다. 연결이 끊긴 뒤
+//      BAND_SESSION_TTL_MS 안에 새 연결의 첫 줄로 "RESUME:<token>\n" 을 보내면
+//      id:pw 로그인 없이 ID, 프로토콜 모드(BIN1), seq 상태, UDP key 가 그대로 복원된다.
+//      응답 "RESUMED\n" (이후 바로 이벤트 전송) 또는 "RESUME FAIL\n" (같은 연결로 id:pw 로그인).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#define BAND_PROTO_HELLO_BIN  "[PROTO]BIN1\n"
+#define BAND_PROTO_BIN_OK     "PROTO BIN1 OK\n"
+#define BAND_PROTO_HELLO_UDP  "[PROTO]UDP1\n"
+#define BAND_PROTO_UDP_REPLY  "UDP1 "          // 뒤에 "<port> <key hex>\n"
+#define BAND_SESSION_REPLY    "SESSION "       // 뒤에 "<token hex>\n"
+#define BAND_RESUME_CMD       "RESUME:"        // 뒤에 "<token hex>\n"
+#define BAND_RESUME_OK        "RESUMED"
+#define BAND_RESUME_FAIL      "RESUME FAIL"
+
+static const int BAND_SESSION_TTL_MS = 30000;   // 끊긴 세션을 서버가 보관하는 시간
+
+static const uint8_t BAND_RECORD_MAGIC = 0xB5;
+
+// 악기 번호 (믹서 채널 순서와 동일: Guita, Drum, Piano)
+enum BandInstrument : uint8_t {
+    BAND_INST_GUITA = 0,
+    BAND_INST_DRUM  = 1,
+    BAND_INST_PIANO = 2,
+    BAND_INST_COUNT
+};
+
+// 악기별 노트 번호
+//   GUITA : 0=G 1=D 2=C
+//   DRUM  : 0=tom_hi 1=tom_mid 2=cymbal_left 3=kick 4=cymbal_right
+//   PIANO : 0=C 1=D 2=E 3=F 4=G 5=A 6=B
+static const uint8_t BAND_NOTE_COUNT[BAND_INST_COUNT] = { 3, 5, 7 };
+
+static const uint8_t BAND_VELOCITY_DEFAULT = 0;    // 0 = 속도 정보 없음(최대 음량)
+static const uint8_t BAND_VELOCITY_MAX     = 127;
+
+// 와이어 레코드 (16바이트, little-endian)
+#pragma pack(push, 1)
+struct BandEventRecord {
+    uint8_t  magic;          // BAND_RECORD_MAGIC
+    uint8_t  instrument;     // BandInstrument
+    uint8_t  note;           // 악기별 노트 번호
+    uint8_t  velocity;       // 1..127, 0 = 기본
+    uint32_t seq;            // 연결(클라이언트)별 1부터 증가
+    uint64_t clientTsUs;     // 클라이언트 단조 시계(us) — 지연/지터 측정용
+};
+#pragma pack(pop)
+
+static_assert(sizeof(BandEventRecord) == 16, "BandEventRecord must be 16 bytes");
+
+// UDP 데이터그램 (20바이트): 서버가 발급한 key + 이벤트 레코드
+#pragma pack(push, 1)
+struct BandUdpDatagram {
+    uint32_t        key;     // little-endian
+    BandEventRecord rec;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(BandUdpDatagram) == 20, "BandUdpDatagram must be 20 bytes");
+
+// ---------- 엔디언 (와이어는 little-endian) ----------
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+static inline uint32_t band_le32(uint32_t v) { return __builtin_bswap32(v); }
+static inline uint64_t band_le64(uint64_t v) { return __builtin_bswap64(v); }
+#else
+static inline uint32_t band_le32(uint32_t v) { return v; }
+static inline uint64_t band_le64(uint64_t v) { return v; }
+#endif
+
+// 클라이언트 단조 시계 (us)
+static inline uint64_t band_now_us()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// 송신용 레코드 생성
+static inline BandEventRecord band_make_event(uint8_t instrument, uint8_t note, uint8_t velocity,
+                                              uint32_t seq, uint64_t clientTsUs)
+{
+    BandEventRecord r;
+    r.magic      = BAND_RECORD_MAGIC;
+    r.instrument = instrument;
+    r.note       = note;
+    r.velocity   = velocity;
+    r.seq        = band_le32(seq);
+    r.clientTsUs = band_le64(clientTsUs);
+    return r;
+}
+
+// 수신: buf 에 최소 sizeof(BandEventRecord) 바이트가 있어야 한다.
+// 레코드가 유효하면 true (host 바이트 순서로 out 에 채움)
+static inline bool band_read_event(const void *buf, size_t avail, BandEventRecord &out)
+{
+    if (avail < sizeof(BandEventRecord)) return false;
+    std::memcpy(&out, buf, sizeof(BandEventRecord));
+    out.seq        = band_le32(out.seq);
+    out.clientTsUs = band_le64(out.clientTsUs);
+    return out.magic == BAND_RECORD_MAGIC
+        && out.instrument < BAND_INST_COUNT
+        && out.note < BAND_NOTE_COUNT[out.instrument]
+        && out.velocity <= BAND_VELOCITY_MAX;
+}
+
+// 텍스트 노트 문자 → 노트 번호 (-1 = 없음)
+static inline int band_note_from_char(uint8_t instrument, char ch)
+{
+    if (ch >= 'a' && ch <= 'z') ch = char(ch - 'a' + 'A');
+    static const char GUITA[] = "GDC";
+    static const char PIANO[] = "CDEFGAB";
+    const char *tbl = (instrument == BAND_INST_GUITA) ? GUITA
+                    : (instrument == BAND_INST_PIANO) ? PIANO : nullptr;
+    if (!tbl) return -1;
+    const char *p = std::strchr(tbl, ch);
+    return (p && ch) ? int(p - tbl) : -1;
+}
+
+// 클라이언트 공통 옵트인: 환경변수 BAND_PROTO=bin 이면 TCP 바이너리, =udp 면 UDP 이벤트 전송
+static inline bool band_binary_requested()
+{
+    const char *v = std::getenv("BAND_PROTO");
+    return v && (std::strcmp(v, "bin") == 0 || std::strcmp(v, "binary") == 0);
+}
+
+static inline bool band_udp_requested()
+{
+    const char *v = std::getenv("BAND_PROTO");
+    return v && std::strcmp(v, "udp") == 0;
+}
+
+#endif // BAND_PROTOCOL_H
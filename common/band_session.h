@@ -0,0 +1,42 @@
+#ifndef BAND_SESSION_H
+#define BAND_SESSION_H
+
+// 클라이언트용 세션 재개 헬퍼 (header-only, POSIX)
+//   1) 로그인("id:pw\n") 직후 band_session_wait(sock, token) 으로 서버가 준 토큰을 받아 둔다
+//   2) 재접속 시 새 소켓에서 band_session_resume(sock, token) → true 면 로그인/프로토콜 협상/UDP
+//      재협상 없이 바로 이벤트를 보낸다. false 면 같은 소켓으로 id:pw 로그인부터 다시.
+
+#include "band_protocol.h"
+#include "band_udp.h"     // band_tcp_wait_line
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <sys/socket.h>
+
+// 로그인 응답에서 세션 토큰을 받는다. 옛 서버(토큰 없음)면 false
+static inline bool band_session_wait(int tcpSock, std::string &token, int timeoutMs = 500)
+{
+    std::string line;
+    if (!band_tcp_wait_line(tcpSock, BAND_SESSION_REPLY, line, timeoutMs)) return false;
+    token = line.substr(std::strlen(BAND_SESSION_REPLY));
+    return !token.empty();
+}
+
+// 새 연결의 첫 줄로 재개 요청. 서버가 RESUMED 라고 답하면 true
+static inline bool band_session_resume(int tcpSock, const std::string &token, int timeoutMs = 500)
+{
+    if (token.empty()) return false;
+    const std::string msg = std::string(BAND_RESUME_CMD) + token + "\n";
+    if (::send(tcpSock, msg.c_str(), msg.size(), 0) != ssize_t(msg.size())) { perror("[SESSION] send(resume)"); return false; }
+
+    std::string reply;
+    if (!band_tcp_wait_line(tcpSock, "RESUME", reply, timeoutMs)) {   // RESUMED / RESUME FAIL
+        fprintf(stderr, "[SESSION] no resume reply\n");
+        return false;
+    }
+    return reply.compare(0, std::strlen(BAND_RESUME_OK), BAND_RESUME_OK) == 0;
+}
+
+#endif // BAND_SESSION_H
@@ -0,0 +1,110 @@
+#ifndef BAND_UDP_H
+#define BAND_UDP_H
+
+// 클라이언트용 UDP 이벤트 송신 헬퍼 (header-only, POSIX)
+//   1) TCP 로그인 후 band_udp_open(tcpSock, serverIp, link)
+//      → "[PROTO]UDP1" 요청, 서버 응답 "UDP1 <port> <key>" 수신, UDP 소켓 connect
+//   2) 노트마다 band_udp_send(link, instrument, note, velocity)
+// 같은 데이터그램을 copies 번 보내 손실에 대비한다 (서버가 seq 로 중복 제거).
+
+#include "band_protocol.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+struct BandUdpLink {
+    int      fd     = -1;
+    uint32_t key    = 0;
+    uint32_t seq    = 0;
+    int      copies = 2;     // BAND_UDP_COPIES 로 변경 (1~4)
+    bool ok() const { return fd >= 0; }
+};
+
+static inline void band_udp_close(BandUdpLink &link)
+{
+    if (link.fd >= 0) ::close(link.fd);
+    link.fd = -1;
+    link.key = 0;
+}
+
+// TCP 소켓에서 prefix 로 시작하는 한 줄을 timeoutMs 안에 기다린다 (다른 줄은 건너뜀)
+static inline bool band_tcp_wait_line(int tcpSock, const char *prefix, std::string &line, int timeoutMs)
+{
+    std::string buf;
+    const uint64_t deadline = band_now_us() + uint64_t(timeoutMs) * 1000;
+    while (band_now_us() < deadline) {
+        pollfd pfd = { tcpSock, POLLIN, 0 };
+        const int waitMs = int((deadline - band_now_us()) / 1000) + 1;
+        if (::poll(&pfd, 1, waitMs) <= 0) break;
+        char ch;
+        const ssize_t n = ::recv(tcpSock, &ch, 1, 0);   // 응답은 짧으므로 1바이트씩 (다음 데이터 침범 방지)
+        if (n <= 0) return false;
+        if (ch != '\n') { buf.push_back(ch); continue; }
+        if (buf.compare(0, std::strlen(prefix), prefix) == 0) { line = buf; return true; }
+        buf.clear();
+    }
+    return false;
+}
+
+static inline bool band_udp_open(int tcpSock, const std::string &serverIp, BandUdpLink &link)
+{
+    band_udp_close(link);
+
+    const char *hello = BAND_PROTO_HELLO_UDP;
+    if (::send(tcpSock, hello, std::strlen(hello), 0) <= 0) { perror("[UDP] send(hello)"); return false; }
+
+    std::string reply;
+    if (!band_tcp_wait_line(tcpSock, BAND_PROTO_UDP_REPLY, reply, 1000)) {
+        fprintf(stderr, "[UDP] no UDP1 reply from server (old server?) -> stay on TCP\n");
+        return false;
+    }
+    unsigned port = 0, key = 0;
+    if (std::sscanf(reply.c_str() + std::strlen(BAND_PROTO_UDP_REPLY), "%u %x", &port, &key) != 2 || !port || !key) {
+        fprintf(stderr, "[UDP] bad reply: %s\n", reply.c_str());
+        return false;
+    }
+
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) { perror("[UDP] socket"); return false; }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(uint16_t(port));
+    if (::inet_pton(AF_INET, serverIp.c_str(), &addr.sin_addr) != 1 ||
+        ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        perror("[UDP] connect");
+        ::close(fd);
+        return false;
+    }
+
+    link.fd  = fd;
+    link.key = key;
+    if (const char *c = std::getenv("BAND_UDP_COPIES")) {
+        const int n = std::atoi(c);
+        link.copies = (n < 1) ? 1 : (n > 4 ? 4 : n);
+    }
+    fprintf(stderr, "[UDP] events -> %s:%u key=%08x copies=%d\n", serverIp.c_str(), port, key, link.copies);
+    return true;
+}
+
+static inline bool band_udp_send(BandUdpLink &link, uint8_t instrument, uint8_t note, uint8_t velocity,
+                                 uint64_t clientTsUs = 0)
+{
+    if (!link.ok()) return false;
+    BandUdpDatagram d;
+    d.key = band_le32(link.key);
+    d.rec = band_make_event(instrument, note, velocity, ++link.seq, clientTsUs ? clientTsUs : band_now_us());
+    bool sent = false;
+    for (int i = 0; i < link.copies; ++i)
+        sent |= (::send(link.fd, &d, sizeof(d), 0) == ssize_t(sizeof(d)));
+    return sent;
+}
+
+#endif // BAND_UDP_H
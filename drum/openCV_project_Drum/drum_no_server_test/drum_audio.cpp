@@ -0,0 +1,163 @@
+#include "drum_audio.h"
+
+#include <alsa/asoundlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+using namespace std;
+
+static const unsigned kLatencyUs = 10000;   // ALSA 버퍼 목표 (period 는 장치가 정함, 보통 1/4~1/2)
+
+/* ----------------------------- DrumMixer ----------------------------- */
+
+bool DrumMixer::trigger(int pad)
+{
+    if (pad < 0 || pad >= kPads) return false;
+    const unsigned h = m_head.load(memory_order_relaxed);
+    if (h - m_tail.load(memory_order_acquire) >= kRing) return false;
+    m_ring[h % kRing] = uint8_t(pad);
+    m_head.store(h + 1, memory_order_release);
+    return true;
+}
+
+void DrumMixer::startVoice(int pad)
+{
+    if (!hasSample(pad)) return;
+    // 빈 voice, 없으면 (같은 패드가 kVoicesPerPad 이상이면 그 중) 가장 오래된 voice
+    Voice *freeV = nullptr, *oldest = nullptr, *oldestSame = nullptr;
+    int same = 0;
+    for (Voice &v : m_voices) {
+        if (v.pad < 0) { if (!freeV) freeV = &v; continue; }
+        if (!oldest || v.age < oldest->age) oldest = &v;
+        if (v.pad == pad) {
+            ++same;
+            if (!oldestSame || v.age < oldestSame->age) oldestSame = &v;
+        }
+    }
+    Voice *v = (same >= kVoicesPerPad) ? oldestSame : (freeV ? freeV : oldest);
+    v->pad = pad;
+    v->pos = 0;
+    v->age = ++m_age;
+}
+
+void DrumMixer::mix(int16_t *out, int frames)
+{
+    // 1) 이번 period 에 도착한 트리거
+    unsigned t = m_tail.load(memory_order_relaxed);
+    const unsigned h = m_head.load(memory_order_acquire);
+    for (; t != h; ++t) startVoice(m_ring[t % kRing]);
+    m_tail.store(t, memory_order_release);
+
+    // 2) 패드별 게인 (이전 period 값 → 현재 값 선형 램프로 지퍼 노이즈 방지)
+    float g0[kPads], dg[kPads];
+    for (int p = 0; p < kPads; ++p) {
+        const float g1 = m_gain[p].load(memory_order_relaxed);
+        g0[p] = m_lastGain[p];
+        dg[p] = (g1 - g0[p]) / float(frames);
+        m_lastGain[p] = g1;
+    }
+
+    // 3) voice 합산
+    m_acc.assign(size_t(frames) * 2, 0.f);
+    for (Voice &v : m_voices) {
+        if (v.pad < 0) continue;
+        const vector<int16_t> &pcm = m_pcm[v.pad];
+        const int total = int(pcm.size() / 2);
+        const int n = min(frames, total - v.pos);
+        const int16_t *src = pcm.data() + size_t(v.pos) * 2;
+        float g = g0[v.pad];
+        const float d = dg[v.pad];
+        for (int i = 0; i < n; ++i, g += d) {
+            m_acc[2*i]     += src[2*i]     * g;
+            m_acc[2*i + 1] += src[2*i + 1] * g;
+        }
+        v.pos += n;
+        if (v.pos >= total) v.pad = -1;
+    }
+
+    for (int i = 0; i < frames * 2; ++i)
+        out[i] = int16_t(max(-32768.f, min(32767.f, m_acc[i])));
+}
+
+/* ----------------------------- DrumAudio ----------------------------- */
+
+bool DrumAudio::load(int pad, const string &path)
+{
+    // 디코더 프로세스는 시작 시 패드당 한 번만 띄운다 (타격마다 띄우던 것을 대체)
+    char cmd[1024];
+    snprintf(cmd, sizeof(cmd), "ffmpeg -nostdin -v error -i \"%s\" -f s16le -ac 2 -ar %d - 2>/dev/null",
+             path.c_str(), DrumMixer::kSampleRate);
+    FILE *p = popen(cmd, "r");
+    if (!p) { perror("[AUDIO] popen(ffmpeg)"); return false; }
+
+    vector<int16_t> pcm;
+    int16_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, sizeof(int16_t), 4096, p)) > 0) pcm.insert(pcm.end(), buf, buf + n);
+    const int rc = pclose(p);
+
+    pcm.resize(pcm.size() & ~size_t(1));
+    if (rc != 0 || pcm.empty()) {
+        cerr << "[AUDIO] decode fail (ffmpeg 필요): " << path << "\n";
+        return false;
+    }
+    cout << "[AUDIO] " << path << " -> " << pcm.size() / 2 << " frames\n";
+    m_mixer.setSample(pad, std::move(pcm));
+    return true;
+}
+
+bool DrumAudio::start()
+{
+    if (m_running) return true;
+
+    snd_pcm_t *pcm = nullptr;
+    int err = snd_pcm_open(&pcm, "default", SND_PCM_STREAM_PLAYBACK, 0);
+    if (err < 0) { cerr << "[AUDIO] snd_pcm_open: " << snd_strerror(err) << "\n"; return false; }
+    err = snd_pcm_set_params(pcm, SND_PCM_FORMAT_S16_LE, SND_PCM_ACCESS_RW_INTERLEAVED,
+                             2, DrumMixer::kSampleRate, 1, kLatencyUs);
+    if (err < 0) {
+        cerr << "[AUDIO] snd_pcm_set_params: " << snd_strerror(err) << "\n";
+        snd_pcm_close(pcm);
+        return false;
+    }
+    snd_pcm_uframes_t bufferFrames = 0, periodFrames = 0;
+    snd_pcm_get_params(pcm, &bufferFrames, &periodFrames);
+
+    m_pcm = pcm;
+    m_period = int(periodFrames ? periodFrames : 256);
+    cout << "[AUDIO] ALSA buffer " << bufferFrames << " frames, period " << m_period << " frames ("
+         << m_period * 1000.0 / DrumMixer::kSampleRate << " ms)\n";
+
+    m_running = true;
+    m_thread = thread(&DrumAudio::run, this);
+    return true;
+}
+
+void DrumAudio::stop()
+{
+    if (!m_running) return;
+    m_running = false;
+    m_thread.join();
+    snd_pcm_t *pcm = static_cast<snd_pcm_t*>(m_pcm);
+    snd_pcm_drop(pcm);
+    snd_pcm_close(pcm);
+    m_pcm = nullptr;
+}
+
+void DrumAudio::run()
+{
+    snd_pcm_t *pcm = static_cast<snd_pcm_t*>(m_pcm);
+    vector<int16_t> buf(size_t(m_period) * 2);
+    while (m_running.load(memory_order_relaxed)) {
+        m_mixer.mix(buf.data(), m_period);
+        // 장치가 period 하나를 비울 때까지 블록 → 다음 mix 가 그 사이 들어온 트리거를 반영
+        snd_pcm_sframes_t w = snd_pcm_writei(pcm, buf.data(), snd_pcm_uframes_t(m_period));
+        if (w < 0) w = snd_pcm_recover(pcm, int(w), 1);   // underrun 등
+        if (w < 0) {
+            cerr << "[AUDIO] snd_pcm_writei: " << snd_strerror(int(w)) << "\n";
+            break;
+        }
+    }
+}
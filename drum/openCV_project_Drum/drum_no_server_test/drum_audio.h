@@ -0,0 +1,82 @@
+#pragma once
+// 드럼 단독 테스트용 프로세스 내 오디오: 시작 시 5개 소리를 한 번만 디코딩해 메모리에 두고,
+// ALSA 출력 스레드가 주기(period)마다 울리는 voice 들을 패드별 게인으로 섞어 내보낸다.
+// 타격 → 소리 지연은 트리거 링 → 다음 period 시작까지, 즉 출력 버퍼 한 개 이내.
+//
+//   DrumAudio audio;
+//   audio.load(0, "sounds/tom_hi.mp4");  ...      // ffmpeg 로 48kHz/stereo/s16 디코딩 (시작 시 1회)
+//   audio.start();                               // ALSA "default" 장치, 출력 스레드 시작
+//   audio.setGain(pad, g);                       // 트랙바 값 (다음 period 부터 울리는 소리에도 적용)
+//   audio.trigger(pad);                          // 메인(영상) 스레드에서 호출, 블록 없음
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+class DrumMixer
+{
+public:
+    static const int kPads          = 5;
+    static const int kMaxVoices     = 16;
+    static const int kVoicesPerPad  = 4;     // 같은 패드 연타는 가장 오래된 voice 를 뺏는다
+    static const int kSampleRate    = 48000;
+
+    // 스테레오 interleaved int16
+    void setSample(int pad, std::vector<int16_t> pcm) { m_pcm[pad] = std::move(pcm); }
+    bool hasSample(int pad) const { return !m_pcm[pad].empty(); }
+
+    // 아무 스레드 (트랙바 콜백/메인 루프)
+    void setGain(int pad, float g) { m_gain[pad].store(g, std::memory_order_relaxed); }
+    // 생산자 = 메인 스레드 하나. 링이 가득 차면 false
+    bool trigger(int pad);
+
+    // 소비자 = 출력 스레드. frames 개 스테레오 프레임을 out 에 채운다
+    void mix(int16_t *out, int frames);
+
+private:
+    struct Voice { int pad = -1; int pos = 0; uint32_t age = 0; };
+
+    void startVoice(int pad);
+
+    std::array<std::vector<int16_t>, kPads> m_pcm;
+    std::array<std::atomic<float>, kPads>   m_gain{};
+    std::array<float, kPads>                m_lastGain{};   // 출력 스레드 전용 (period 안에서 선형 램프)
+    Voice    m_voices[kMaxVoices];
+    uint32_t m_age = 0;
+    std::vector<float> m_acc;
+
+    // 트리거 SPSC 링 (패드 번호)
+    static const unsigned kRing = 64;
+    uint8_t m_ring[kRing] = {};
+    alignas(64) std::atomic<unsigned> m_head{0};
+    alignas(64) std::atomic<unsigned> m_tail{0};
+};
+
+class DrumAudio
+{
+public:
+    ~DrumAudio() { stop(); }
+
+    // path 를 ffmpeg 로 디코딩해 pad 에 넣는다. 실패하면 false (그 패드는 무음)
+    bool load(int pad, const std::string &path);
+    // 출력 장치를 열고 스레드 시작. 장치가 없으면 false
+    bool start();
+    void stop();
+    bool running() const { return m_running.load(); }
+
+    void setGain(int pad, float g) { m_mixer.setGain(pad, g); }
+    bool trigger(int pad) { return m_mixer.trigger(pad); }
+    int  periodFrames() const { return m_period; }
+
+private:
+    void run();
+
+    DrumMixer         m_mixer;
+    void             *m_pcm = nullptr;   // snd_pcm_t* (헤더에 alsa 를 끌어오지 않음)
+    int               m_period = 0;
+    std::thread       m_thread;
+    std::atomic<bool> m_running{false};
+};
@@ -6,6 +6,8 @@
 #include <chrono>
 #include <cstdlib>
 
+#include "drum_audio.h"
+
 using namespace cv;
 using namespace std;
 
@@ -37,7 +39,8 @@ static void putCenteredLabel(Mat& img, const string& text, Point center,
 }
 
 /* --------- MP3/MP4 재생기 (ffplay → gstreamer → vlc) + 볼륨 --------- */
-/* gain: 선형배수 (1.0=100%, 0.5=50%, 2.0=200%) */
+/* gain: 선형배수 (1.0=100%, 0.5=50%, 2.0=200%)
+   타격마다 프로세스+디코더를 띄우므로 느리다(100ms+). 오디오 장치를 못 열었을 때만 쓰는 대체 경로 */
 static inline void playSoundAsync(const string& path, double gain) {
     std::thread([path, gain](){
         char cmd[2048];
@@ -125,6 +128,11 @@ int main(int argc, char** argv){
         {false,0,0, chrono::steady_clock::now(), "sounds/cymbal_right.mp4"}   // 4: Cymbal-R
     };
 
+    // 🔊 소리는 시작 시 한 번만 디코딩 → 프로세스 내 믹서로 재생 (장치가 없으면 외부 플레이어로 대체)
+    DrumAudio audio;
+    for (size_t i = 0; i < states.size(); ++i) audio.load(int(i), states[i].sound);
+    if (!audio.start()) cerr << "[AUDIO] in-process output unavailable -> external player per hit\n";
+
     // 카메라/배경
     VideoCapture cap; if (!cap.open(0, cv::CAP_V4L2)){ cerr<<"camera open fail\n"; return -1; }
     cap.set(CAP_PROP_FPS,30);
@@ -199,6 +207,12 @@ int main(int argc, char** argv){
             (std::max(0, volCymR100  ) / 100.0) * master   // idx 4
         };
 
+        for (int p = 0; p < DrumMixer::kPads; ++p) audio.setGain(p, float(vol[p]));   // 울리는 소리에도 바로 반영
+        auto play = [&](size_t pad){
+            if (audio.running()) audio.trigger(int(pad));
+            else playSoundAsync(states[pad].sound, vol[pad]);
+        };
+
         // 겹침 계산 & 상태 업데이트 & 그리기
         double thr=thPercent/100.0;
         size_t idx=0;
@@ -216,7 +230,7 @@ int main(int argc, char** argv){
                     auto now=chrono::steady_clock::now();
                     int ms = (int)chrono::duration_cast<chrono::milliseconds>(now - states[idx].last_fire).count();
                     if (ms >= cooldown_ms && !states[idx].sound.empty()){
-                        playSoundAsync(states[idx].sound, vol[idx]); // 🔊 볼륨 반영
+                        play(idx); // 🔊 볼륨은 믹서에서 반영
                         states[idx].last_fire = now;
                     }
                 }
@@ -241,7 +255,7 @@ int main(int argc, char** argv){
                     auto now=chrono::steady_clock::now();
                     int ms = (int)chrono::duration_cast<chrono::milliseconds>(now - states[idx].last_fire).count();
                     if (ms >= cooldown_ms && !states[idx].sound.empty()){
-                        playSoundAsync(states[idx].sound, vol[idx]); // 🔊 볼륨 반영
+                        play(idx); // 🔊 볼륨은 믹서에서 반영
                         states[idx].last_fire = now;
                     }
                 }
@@ -278,14 +292,11 @@ int main(int argc, char** argv){
         if(key=='b'){ bg=createBackgroundSubtractorMOG2(500,varThr,true); bg->setDetectShadows(false); cout<<"BG reset\n"; }
 
         // 강제 재생(경로/볼륨 체크용) 1~5
-        if(key=='1') playSoundAsync("sounds/tom_hi.mp4",      vol[0]);
-        if(key=='2') playSoundAsync("sounds/tom_mid.mp4",     vol[1]);
-        if(key=='3') playSoundAsync("sounds/cymbal_left.mp3", vol[2]);
-        if(key=='4') playSoundAsync("sounds/kick.mp4",        vol[3]);
-        if(key=='5') playSoundAsync("sounds/cymbal_right.mp4",vol[4]);
+        if(key>='1' && key<='5') play(size_t(key-'1'));
     }
 
     // 종료 시 정리
+    audio.stop();
     destroyAllWindows();
     return 0;
 }
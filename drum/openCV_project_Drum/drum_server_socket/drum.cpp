@@ -5,7 +5,12 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
+#include <time.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -13,6 +18,13 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 
+#include "band_capture.h"
+#include "band_protocol.h"
+#include "band_udp.h"
+#include "frame_pipeline.h"
+#include "pad_labels.h"
+#include "stick_tracker.h"
+
 using namespace cv;
 using namespace std;
 
@@ -23,6 +35,7 @@ struct EllipseROI{ Point c; Size axes; double ang; string name; bool active=fals
 struct ROIState {
     bool active=false;
     int on_cnt=0, off_cnt=0;
+    bool early=false;   // 스틱 추적이 먼저 울림 → 이어지는 히스테리시스 진입은 같은 타격
     chrono::steady_clock::time_point last_fire = chrono::steady_clock::now();
 };
 
@@ -71,6 +84,106 @@ static void makeMixedROIs(Size sz, vector<CircleROI>& circles, vector<EllipseROI
     }
 }
 
+/* -------- 패드 검출기: 처리 해상도(procSize)에서 배경 차분 + 패드 상태 머신 --------
+ * 카메라 프레임을 곧바로 procSize 로 줄여(INTER_AREA) 블러/MOG2/패드 판정을 그 격자에서 한다.
+ * ROI 는 정규화 좌표라 같은 makeMixedROIs 로 procSize 에 다시 그린다 (패드 번호는 화면용과 같다).
+ * 화면 합성만 드럼 그림 해상도로 따로 한다.
+ *
+ * predict 이면 스틱 끝 추적(stick_tracker.h)이 접촉 한 프레임 전에 속도(velocity)와 함께 먼저 울리고,
+ * 겹침 비율 히스테리시스는 추적이 놓친 타격만 울린다 (같은 타격이면 early 로 건너뜀). */
+static Size procSizeFor(Size art, int procW){
+    if (procW <= 0 || procW >= art.width) return art;
+    return Size(procW, max(1, int(double(art.height) * procW / art.width + 0.5)));
+}
+
+struct PadHit { int pad, velocity; bool predicted; };
+
+struct PadDetector {
+    static constexpr double kOverlapThr = 0.03;   // 패드 면적 대비 전경 비율
+    static const int kEnterFrames = 2, kExitFrames = 3, kCooldownMs = 120;
+    static const int kEarlyHoldMs = 250;          // 추적이 울린 뒤 이 안에 히스테리시스가 들어오면 같은 타격
+
+    Size procSize;
+    PadLabelMap padMap;
+    StickTracker sticks;
+    bool predict;
+    vector<ROIState> states;
+    vector<StickOnset> onsets;
+    Ptr<BackgroundSubtractorMOG2> bg;
+    int blurK = 5;          // 960px 기준 5x5 를 비율대로 (3 미만이면 INTER_AREA 축소가 대신함)
+    Mat small, gray, fg, pen;
+
+    // 덩어리 면적 범위: 960px 기준 80~5000 을 처리 해상도 면적 비율대로
+    PadDetector(Size art, int procW, bool predictOnset)
+        : procSize(procSizeFor(art, procW)), padMap(procSize),
+          sticks(padMap, max(4, areaAt(80)), areaAt(5000)), predict(predictOnset) {
+        vector<CircleROI> cR; vector<EllipseROI> eR;
+        makeMixedROIs(procSize, cR, eR);
+        Mat m(procSize, CV_8U);
+        for (auto&r:cR){ m.setTo(Scalar(0)); circle(m,r.c,r.r,Scalar(255),FILLED,LINE_AA); padMap.addPad(m); }
+        for (auto&e:eR){ m.setTo(Scalar(0)); ellipse(m,e.c,e.axes,e.ang,0,360,Scalar(255),FILLED,LINE_AA); padMap.addPad(m); }
+        states.resize(padMap.pads());
+
+        bg = createBackgroundSubtractorMOG2(500,20,true);
+        bg->setDetectShadows(false);
+        bg->setVarThreshold(20);
+
+        blurK = int(5.0 * procSize.width / 960 + 0.5) | 1;
+    }
+
+    int pads() const { return padMap.pads(); }
+    int areaAt(int area960) const { const double s = procSize.width / 960.0; return int(area960 * s * s + 0.5); }
+
+    // 쿨다운 안이면 버림
+    bool fire(int idx, int velocity, bool predicted, chrono::steady_clock::time_point now, vector<PadHit>& fired){
+        ROIState &st = states[idx];
+        if (chrono::duration_cast<chrono::milliseconds>(now - st.last_fire).count() < kCooldownMs) return false;
+        fired.push_back({idx, velocity, predicted});
+        st.last_fire = now;
+        return true;
+    }
+
+    // frame: 카메라 원본 (BGR). 이번 프레임에 울릴 패드를 fired 에 담는다. pen 은 procSize 전경 마스크
+    void process(const Mat& frame, chrono::steady_clock::time_point now, vector<PadHit>& fired){
+        fired.clear();
+        resize(frame, small, procSize, 0, 0, INTER_AREA);
+        cvtColor(small, gray, COLOR_BGR2GRAY);
+        if (blurK >= 3) GaussianBlur(gray, gray, Size(blurK,blurK), 0);
+        bg->apply(gray, fg);
+        threshold(fg, pen, 200, 255, THRESH_BINARY);
+
+        // 전경 마스크를 한 번 훑어 패드별 겹침 픽셀 수를 한꺼번에 센다
+        int overlap[PadLabelMap::kMaxPads];
+        padMap.count(pen, overlap);
+
+        if (predict) {
+            sticks.update(pen, chrono::duration<double>(now.time_since_epoch()).count(), onsets);
+            for (const auto& o : onsets)
+                if (fire(o.pad, o.velocity, o.predicted, now, fired)) states[o.pad].early = true;
+        }
+
+        for (int idx=0; idx<pads(); ++idx){
+            ROIState &st = states[idx];
+            const double frac = (padMap.area(idx)>0)? (double)overlap[idx]/padMap.area(idx) : 0.0;
+            if (frac >= kOverlapThr){
+                st.on_cnt++;
+                st.off_cnt=0;
+                if (!st.active && st.on_cnt>=kEnterFrames){
+                    st.active = true;
+                    const int ms = (int)chrono::duration_cast<chrono::milliseconds>(now - st.last_fire).count();
+                    if (!(st.early && ms < kEarlyHoldMs))
+                        fire(idx, predict ? sticks.velocityFor(idx) : BAND_VELOCITY_DEFAULT, false, now, fired);
+                    st.early = false;
+                }
+            } else {
+                st.off_cnt++;
+                st.on_cnt=0;
+                if (st.active && st.off_cnt>=kExitFrames) st.active=false;
+            }
+        }
+    }
+};
+
 /* ------------- 카메라 열기 유틸(경로/인덱스/자동 스캔 + 폴백) ------------- */
 static bool tryOpen(VideoCapture &cap, const string& target, int apiPreference)
 {
@@ -128,6 +241,108 @@ static bool openBestCamera(VideoCapture &cap, const string& devPath, int idxHint
     return false;
 }
 
+// BAND_CAPTURE=fast: 지정 장치(경로/인덱스) 또는 자동 스캔 경로 후보를 고속 모드로 연다. 실패하면 호출한 쪽이 기존 방식으로
+static bool openFastCamera(VideoCapture &cap, const string& devPath, int idxHint, int minWidth, BandCaptureFormat& fmt)
+{
+    vector<string> devs;
+    if (!devPath.empty()) devs.push_back(devPath);
+    else if (idxHint >= 0) devs.push_back("/dev/video" + to_string(idxHint));
+    else devs = { "/dev/video1", "/dev/video2", "/dev/video3", "/dev/video0" };
+    for (const auto& dev : devs)
+        if (band_capture_open_fast(cap, dev, fmt, minWidth)) return true;
+    return false;
+}
+
+/* -------- 처리 해상도 / 온셋 벤치마크 (DRUM_BENCH=<녹화 파일>) --------
+ * 같은 녹화를 설정마다 처음부터 돌려 프레임당 CPU 시간과 타격 정확도/지연을 잰다.
+ * 기준 = 드럼 그림 해상도(예전 처리 폭) + 히스테리시스에서 나온 타격. 같은 패드가 ±3프레임 안에 나오면 일치로 보고,
+ * offset(일치한 타격의 평균 프레임 차, 음수 = 기준보다 먼저 울림)이 곧 지연 차이다.
+ * 처리 폭마다 히스테리시스(hyst)와 예측 온셋(pred) 두 줄을 낸다.
+ * 시각은 프레임 번호 기반(녹화 fps)이라 쿨다운도 재현 가능하다. 서버 접속/화면 없음. */
+struct BenchHit { int frame, pad, velocity; bool predicted; };
+
+static double cpuMs(){
+    timespec ts; clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);   // OpenCV 내부 스레드 포함
+    return ts.tv_sec*1e3 + ts.tv_nsec/1e6;
+}
+
+static bool benchOnce(const string& video, Size art, int procW, bool predict, vector<BenchHit>& hits,
+                      vector<double>& cpu, double& wallMs, Size& procSize, double& fps){
+    VideoCapture cap(video);
+    if (!cap.isOpened()) { cerr << "[BENCH] cannot open " << video << "\n"; return false; }
+    fps = cap.get(CAP_PROP_FPS);
+    if (!(fps > 1 && fps < 1000)) fps = 30;
+
+    PadDetector det(art, procW, predict);
+    procSize = det.procSize;
+    vector<PadHit> fired;
+    Mat frame;
+    const auto t0 = chrono::steady_clock::now();   // 쿨다운 기준 시각 (프레임 번호로 전진)
+    wallMs = 0;
+    for (int n=0; cap.read(frame) && !frame.empty(); ++n){
+        const auto now = t0 + chrono::microseconds(int64_t(n * 1e6 / fps));
+        const double c0 = cpuMs();
+        const auto w0 = chrono::steady_clock::now();
+        det.process(frame, now, fired);
+        wallMs += chrono::duration<double, milli>(chrono::steady_clock::now() - w0).count();
+        cpu.push_back(cpuMs() - c0);
+        for (const auto& h : fired) hits.push_back({n, h.pad, h.velocity, h.predicted});
+    }
+    return true;
+}
+
+static int runScaleBench(const string& video, Size art, const string& widthList){
+    vector<int> widths;
+    for (size_t pos=0; pos<widthList.size(); ){
+        size_t end = widthList.find(',', pos);
+        if (end == string::npos) end = widthList.size();
+        const int w = atoi(widthList.substr(pos, end-pos).c_str());
+        if (w > 0 && w < art.width) widths.push_back(w);
+        pos = end + 1;
+    }
+
+    // (처리 폭, 예측 여부). 첫 줄이 기준
+    vector<pair<int,bool>> runs = {{art.width, false}, {art.width, true}};
+    for (int w : widths) { runs.push_back({w, false}); runs.push_back({w, true}); }
+
+    vector<BenchHit> ref;
+    for (size_t k=0; k<runs.size(); ++k){
+        vector<BenchHit> hits; vector<double> cpu; double wallMs = 0, fps = 30; Size ps;
+        if (!benchOnce(video, art, runs[k].first, runs[k].second, hits, cpu, wallMs, ps, fps)) return -1;
+        if (k == 0) ref = hits;
+
+        // 기준 타격과 짝짓기 (같은 패드, ±3프레임, 가까운 것 한 번씩만)
+        vector<char> used(hits.size(), 0);
+        int matched = 0; double offSum = 0;
+        for (const auto& r : ref){
+            int best = -1;
+            for (size_t i=0; i<hits.size(); ++i){
+                if (used[i] || hits[i].pad != r.pad || abs(hits[i].frame - r.frame) > 3) continue;
+                if (best < 0 || abs(hits[i].frame - r.frame) < abs(hits[best].frame - r.frame)) best = int(i);
+            }
+            if (best < 0) continue;
+            used[best] = 1; ++matched; offSum += hits[best].frame - r.frame;
+        }
+        size_t pred = 0, velN = 0; double velSum = 0;
+        for (const auto& h : hits) {
+            pred += h.predicted;
+            if (h.velocity > 0) { velSum += h.velocity; ++velN; }
+        }
+        vector<double> sorted = cpu;
+        sort(sorted.begin(), sorted.end());
+        double sum = 0; for (double c : cpu) sum += c;
+        const size_t n = cpu.size();
+        const double off = matched ? offSum/matched : 0.0;
+        fprintf(stderr, "[BENCH] %4dx%-4d %s frames %zu  cpu avg %.2f p95 %.2f max %.2f ms  wall avg %.2f ms  "
+                        "hits %zu (pred %zu)  recall %d/%zu  extra %zu  offset %+.2f fr %+.1f ms  vel avg %.0f\n",
+                ps.width, ps.height, runs[k].second ? "pred" : "hyst", n,
+                n ? sum/n : 0.0, n ? sorted[min(n-1, n*95/100)] : 0.0, n ? sorted.back() : 0.0,
+                n ? wallMs/n : 0.0, hits.size(), pred, matched, ref.size(), hits.size() - matched,
+                off, off * 1000.0 / fps, velN ? velSum/velN : 0.0);
+    }
+    return 0;
+}
+
 /* ------------------------------- 메인 ------------------------------- */
 int main(int argc, char** argv){
     // 사용법 안내
@@ -145,6 +360,21 @@ int main(int argc, char** argv){
     if (drum.empty()){ cerr<<"cannot read "<<img_path<<"\n"; return -1; }
     if (drum.cols>maxW){ double s=double(maxW)/drum.cols; resize(drum,drum,Size(),s,s,INTER_AREA); }
 
+    // 검출 처리 폭 (화면은 드럼 그림 해상도 그대로). 0 이면 그림 해상도에서 처리
+    const char *procEnv = getenv("DRUM_PROC_WIDTH");
+    const int procW = procEnv ? atoi(procEnv) : 320;
+
+    // 타격 판정: 기본은 겹침 히스테리시스. DRUM_ONSET=pred 면 스틱 끝 추적으로 접촉을 예측해 속도와 함께 울림
+    // (실제 녹화로 DRUM_BENCH 결과를 확인하기 전까지는 예측을 기본으로 두지 않는다)
+    const char *onsetEnv = getenv("DRUM_ONSET");
+    const bool predictOnset = onsetEnv && !strcmp(onsetEnv, "pred");
+
+    // DRUM_BENCH=<녹화 파일> [DRUM_BENCH_WIDTHS=480,320,240,160] : 처리 폭/온셋별 CPU/정확도/지연만 재고 끝
+    if (const char *benchVideo = getenv("DRUM_BENCH")) {
+        const char *wl = getenv("DRUM_BENCH_WIDTHS");
+        return runScaleBench(benchVideo, drum.size(), wl ? wl : "480,320,240,160");
+    }
+
     // TCP 연결
     int sock = ::socket(AF_INET, SOCK_STREAM, 0);
     if (sock < 0) { perror("socket"); return -1; }
@@ -196,25 +426,30 @@ int main(int argc, char** argv){
         if (n < 0) perror("send(login)");
     }
 
+    // BAND_PROTO=bin 이면 바이너리 레코드로 전송 (서버가 이 줄 다음 바이트부터 레코드로 해석)
+    const bool useBinary = band_binary_requested();
+    uint32_t seq = 0;
+    if (useBinary) {
+        const char *hello = BAND_PROTO_HELLO_BIN;
+        if (::send(sock, hello, strlen(hello), 0) < 0) perror("send(proto hello)");
+        else cout << "[NET] binary protocol requested" << endl;
+    }
+
+    // BAND_PROTO=udp 이면 타격은 UDP 로 (로그인 TCP 연결은 유지, 서버 응답 없으면 텍스트로)
+    BandUdpLink udp;
+    if (band_udp_requested() && !band_udp_open(sock, server_ip, udp))
+        cerr << "[NET] UDP channel unavailable -> TCP text" << endl;
+
 
     // ROI 준비
     vector<CircleROI> cROIs; vector<EllipseROI> eROIs;
     makeMixedROIs(drum.size(), cROIs, eROIs);
 
-    vector<Mat> masks; vector<int> areas;
-    for (auto&r:cROIs){
-        Mat m=Mat::zeros(drum.size(),CV_8U);
-        circle(m,r.c,r.r,Scalar(255),FILLED,LINE_AA);
-        masks.push_back(m); areas.push_back(countNonZero(m));
-    }
-    for (auto&e:eROIs){
-        Mat m=Mat::zeros(drum.size(),CV_8U);
-        ellipse(m,e.c,e.axes,e.ang,0,360,Scalar(255),FILLED,LINE_AA);
-        masks.push_back(m); areas.push_back(countNonZero(m));
-    }
-
-    // ROI 상태 5개
-    vector<ROIState> states(5);
+    // 검출기 (처리 해상도에서 ROI 라벨 맵/MOG2/상태). ROI 는 화면용(cROIs/eROIs)과 같은 정규화 좌표
+    PadDetector det(drum.size(), procW, predictOnset);
+    const int nPads = det.pads();
+    cout << "[INFO] detect at " << det.procSize.width << "x" << det.procSize.height
+         << " (display " << drum.cols << "x" << drum.rows << "), onset " << (predictOnset ? "predict" : "hyst") << "\n";
 
     // 카메라 열기
     VideoCapture cap;
@@ -227,84 +462,167 @@ int main(int argc, char** argv){
         else devPath = cam_arg;
     }
 
-    if (!openBestCamera(cap, devPath, idxHint)) {
-        cerr<<"camera open fail (tried devPath='"<<devPath<<"', idxHint="<<idxHint<<")\n";
-        ::close(sock);
-        return -1;
+    // BAND_CAPTURE=fast 면 장치의 최고 fps 모드 (처리 격자보다 좁은 크기는 고르지 않음) + 드라이버 프레임 시각
+    BandCaptureFormat capFmt;
+    const bool fastCap = band_fast_capture_requested()
+                         && openFastCamera(cap, devPath, idxHint, det.procSize.width, capFmt);
+    if (!fastCap) {
+        if (!openBestCamera(cap, devPath, idxHint)) {
+            cerr<<"camera open fail (tried devPath='"<<devPath<<"', idxHint="<<idxHint<<")\n";
+            ::close(sock);
+            return -1;
+        }
+        cap.set(CAP_PROP_FPS,30);
     }
-    cap.set(CAP_PROP_FPS,30);
-
-    Ptr<BackgroundSubtractorMOG2> bg=createBackgroundSubtractorMOG2(500,20,true);
-    bg->setDetectShadows(false);
-
-    int varThr=20;
-    const int enter_frames=2, exit_frames=3, cooldown_ms=120;
-    int minArea=80, maxArea=5000;
-
-    Mat cam,camRsz,fg,vis;
-
-    cout << "[INFO] Press 'q' or ESC to quit.\n";
-    while(true){
-        if(!cap.read(cam)||cam.empty()) break;
-        resize(cam,camRsz,drum.size());
-
-        Mat gray; cvtColor(camRsz,gray,COLOR_BGR2GRAY);
-        GaussianBlur(gray,gray,Size(5,5),0);
-        bg->setVarThreshold(varThr);
-        bg->apply(gray,fg);
-
-        Mat pen; threshold(fg,pen,200,255,THRESH_BINARY);
-
-        vis=drum.clone(); 
-        camRsz.copyTo(vis,pen);
-
-        double thr=0.03;
-        size_t idx=0;
-
-        // ROI 체크
-        for(size_t i=0;i<masks.size();++i,++idx){
-            Mat inter; bitwise_and(pen, masks[i], inter);
-            double frac = (areas[i]>0)? (double)countNonZero(inter)/areas[i] : 0.0;
-            bool hit = (frac >= thr);
-
-            if (hit){
-                states[idx].on_cnt++; 
-                states[idx].off_cnt=0;
-                if (!states[idx].active && states[idx].on_cnt>=enter_frames){
-                    states[idx].active = true;
-                    auto now=chrono::steady_clock::now();
-                    int ms = (int)chrono::duration_cast<chrono::milliseconds>(now - states[idx].last_fire).count();
-                    if (ms >= cooldown_ms){
-                        string msg = "[DRUM]"+to_string(idx) + "\n"; // 개행 추가 권장
-                        ssize_t n = ::send(sock, msg.c_str(), msg.size(), 0);
-                        if (n < 0) perror("send([DRUM])");
-                        else cout << "[NET] Sent: " << msg;
-                        states[idx].last_fire = now;
-                    }
-                }
-            } else {
-                states[idx].off_cnt++; 
-                states[idx].on_cnt=0;
-                if (states[idx].active && states[idx].off_cnt>=exit_frames) 
-                    states[idx].active=false;
-            }
 
-            Scalar col = states[idx].active? Scalar(0,0,255):Scalar(0,255,0);
-            if (i<2) circle(vis, cROIs[i].c, cROIs[i].r, col, 4, LINE_AA);
-            else     ellipse(vis, eROIs[i-2].c, eROIs[i-2].axes, eROIs[i-2].ang, 0, 360, col, 4, LINE_AA);
+    // 타격 전송 (검출 스레드 전용: 소켓/UDP 링크/seq 는 이 스레드만 만진다). vel 0 = 속도 정보 없음.
+    // frameUs: 판정한 프레임의 캡처 시각 (band_now_us 축) → 이벤트 시각으로 보내 서버가 프레임부터 도착까지를 잰다
+    auto sendHit = [&](int idx, int vel, uint64_t frameUs){
+        if (udp.ok()) {
+            if (!band_udp_send(udp, BAND_INST_DRUM, uint8_t(idx), uint8_t(vel), frameUs))
+                perror("send(udp)");
+            else cout << "[NET] Sent: DRUM " << idx << " v" << vel << " #" << udp.seq << " (udp)\n";
+        } else if (useBinary) {
+            BandEventRecord rec = band_make_event(BAND_INST_DRUM, uint8_t(idx),
+                                                  uint8_t(vel), ++seq, frameUs);
+            ssize_t n = ::send(sock, &rec, sizeof(rec), 0);
+            if (n < 0) perror("send(record)");
+            else cout << "[NET] Sent: DRUM " << idx << " v" << vel << " #" << seq << "\n";
+        } else {
+            string msg = "[DRUM]"+to_string(idx) + (vel>0 ? ","+to_string(vel) : "") + "\n"; // 개행 추가 권장
+            ssize_t n = ::send(sock, msg.c_str(), msg.size(), 0);
+            if (n < 0) perror("send([DRUM])");
+            else cout << "[NET] Sent: " << msg;
+        }
+    };
+
+    /* ---------------- 파이프라인: 캡처 스레드 → 검출 스레드 → 화면(메인 스레드) ----------------
+     * 단계 사이는 깊이 1 슬롯(최신 프레임 우선)이라 느린 단계가 앞 단계를 막지 않는다.
+     * 카메라 read() 블록과 HighGUI 그리기가 타격 판정 앞에 놓이지 않고, 판정 즉시 전송한다.
+     * 화면은 HighGUI 가 메인 스레드를 요구하는 백엔드가 있어 메인 스레드에서 DRUM_DISPLAY_FPS(기본 15)로만 그린다.
+     * 프레임 시각 t 는 고속 캡처면 드라이버 버퍼 시각, 아니면 read() 가 돌아온 시각. 이후 지연은 모두 t 기준이다. */
+    using Clock = chrono::steady_clock;
+    struct CapFrame  { Mat img; Clock::time_point t; uint64_t n=0; };
+    struct ShowFrame { Mat cam, pen; vector<char> active; uint64_t n=0; };
+
+    const char *dispEnv = getenv("DRUM_DISPLAY_FPS");
+    const int displayFps = max(1, dispEnv ? atoi(dispEnv) : 15);
+
+    LatestSlot<CapFrame>  capSlot;
+    LatestSlot<ShowFrame> showSlot;
+    StageStats capStat, ageStat, detStat, lagStat, hitStat, dispStat;
+    atomic<bool> running{true};
+
+    thread capThread([&]{
+        CapFrame f;
+        uint64_t n = 0;
+        while (running) {
+            const auto t0 = Clock::now();
+            if (!cap.read(f.img) || f.img.empty()) break;
+            const auto tr = Clock::now();
+            f.t = tr;
+            if (fastCap) {
+                const uint64_t readUs = uint64_t(chrono::duration_cast<chrono::microseconds>(tr.time_since_epoch()).count());
+                f.t = Clock::time_point(chrono::microseconds(band_capture_frame_us(cap, readUs)));
+            }
+            f.n = ++n;
+            capStat.add(tr - t0);
+            ageStat.add(tr - f.t);   // 드라이버 시각 → read() 반환 (디코드/큐 대기)
+            capSlot.put(f);   // 검출이 못 따라오면 이전 프레임을 덮어쓴다
         }
+        running = false;
+        capSlot.close();
+    });
+
+    thread detThread([&]{
+        CapFrame f;
+        ShowFrame out;
+        vector<PadHit> fired;
+        while (running) {
+            if (!capSlot.take(f, chrono::milliseconds(100))) continue;
+            const auto t0 = Clock::now();
+            lagStat.add(t0 - f.t);   // 캡처 완료 → 검출 시작 (슬롯 대기)
+
+            det.process(f.img, f.t, fired);   // 추적 속도/쿨다운은 캡처 시각 기준
+            const uint64_t frameUs = uint64_t(chrono::duration_cast<chrono::microseconds>(f.t.time_since_epoch()).count());
+            for (const auto& h : fired) {
+                sendHit(h.pad, h.velocity, frameUs);
+                hitStat.add(Clock::now() - f.t);   // 프레임 시각 → 전송
+            }
+            detStat.add(Clock::now() - t0);
+
+            // 화면용: 원본 프레임과 처리 해상도 마스크를 넘기고 확대/합성은 화면 스레드가 한다.
+            // 원본 버퍼는 슬롯끼리 바꿔 쓴다 (캡처 슬롯에서 받은 f.img 를 그대로 넘기고 out 의 헌 버퍼를 돌려받음)
+            swap(out.cam, f.img);
+            det.pen.copyTo(out.pen);
+            out.active.resize(nPads);
+            for (int idx=0; idx<nPads; ++idx) out.active[idx] = det.states[idx].active;
+            out.n = f.n;
+            showSlot.put(out);
+        }
+        running = false;
+        showSlot.close();
+    });
+
+    // 화면 (메인 스레드)
+    ShowFrame sf;
+    Mat vis, camBig, penBig;
+    const auto dispPeriod = chrono::microseconds(1000000 / displayFps);
+    auto nextDisp = Clock::now();
+    auto nextReport = Clock::now() + chrono::seconds(5);
+    uint64_t lastCapPuts = 0, lastCapDrop = 0, lastShowDrop = 0;
+
+    cout << "[INFO] Press 'q' or ESC to quit. display " << displayFps << " fps\n";
+    while (running) {
+        if (showSlot.take(sf, chrono::milliseconds(50))) {
+            const auto t0 = Clock::now();
+            drum.copyTo(vis);
+            resize(sf.cam, camBig, drum.size());
+            resize(sf.pen, penBig, drum.size(), 0, 0, INTER_NEAREST);
+            camBig.copyTo(vis, penBig);
+            const int nc = int(cROIs.size());
+            for (int idx=0; idx<nPads; ++idx) {
+                Scalar col = sf.active[idx]? Scalar(0,0,255):Scalar(0,255,0);
+                if (idx<nc) circle(vis, cROIs[idx].c, cROIs[idx].r, col, 4, LINE_AA);
+                else        ellipse(vis, eROIs[idx-nc].c, eROIs[idx-nc].axes, eROIs[idx-nc].ang, 0, 360, col, 4, LINE_AA);
+            }
+
+            // (선택) 각 ROI 중앙에 라벨 표시
+            for (auto&r:cROIs) putCenteredLabel(vis, r.name, r.c, 0.6, 2, Scalar(0,255,255));
+            for (auto&e:eROIs) putCenteredLabel(vis, e.name, e.c, 0.6, 2, Scalar(0,255,255));
 
-        // (선택) 각 ROI 중앙에 라벨 표시
-        for (int i=0;i<2;i++) putCenteredLabel(vis, cROIs[i].name, cROIs[i].c, 0.6, 2, Scalar(0,255,255));
-        putCenteredLabel(vis, eROIs[0].name, eROIs[0].c, 0.6, 2, Scalar(0,255,255));
-        putCenteredLabel(vis, eROIs[1].name, eROIs[1].c, 0.6, 2, Scalar(0,255,255));
-        putCenteredLabel(vis, eROIs[2].name, eROIs[2].c, 0.6, 2, Scalar(0,255,255));
+            imshow("Drum Client", vis);
+            dispStat.add(Clock::now() - t0);
+        }
 
-        imshow("Drum Client", vis);
-        int key=waitKey(1);
+        // 다음 화면 시각까지 HighGUI 이벤트 처리 겸 대기 (그 사이 검출은 계속 돈다)
+        nextDisp += dispPeriod;
+        const auto now = Clock::now();
+        if (nextDisp < now) nextDisp = now;
+        const int waitMs = max(1, (int)chrono::duration_cast<chrono::milliseconds>(nextDisp - now).count());
+        int key=waitKey(waitMs);
         if(key==27||key=='q') break;
+
+        if (Clock::now() >= nextReport) {
+            nextReport += chrono::seconds(5);
+            const auto c = capStat.take(), a = ageStat.take(), l = lagStat.take(), d = detStat.take(),
+                       h = hitStat.take(), v = dispStat.take();
+            const uint64_t capPuts = capSlot.puts(), capDrop = capSlot.overwritten(), showDrop = showSlot.overwritten();
+            fprintf(stderr, "[PIPE] cap %.1ffps read %.1f/%.1fms age %.1f/%.1fms q%d drop %llu | det %.1ffps wait %.1f/%.1fms run %.1f/%.1fms q%d"
+                            " | hit %llu %.1f/%.1fms from %s | disp %.1ffps %.1f/%.1fms skip %llu\n",
+                    (capPuts - lastCapPuts) / 5.0, c.avgMs, c.maxMs, a.avgMs, a.maxMs, capSlot.depth(), (unsigned long long)(capDrop - lastCapDrop),
+                    d.n / 5.0, l.avgMs, l.maxMs, d.avgMs, d.maxMs, showSlot.depth(),
+                    (unsigned long long)h.n, h.avgMs, h.maxMs, fastCap ? "driver" : "read",
+                    v.n / 5.0, v.avgMs, v.maxMs, (unsigned long long)(showDrop - lastShowDrop));
+            lastCapPuts = capPuts; lastCapDrop = capDrop; lastShowDrop = showDrop;
+        }
     }
 
+    running = false;
+    capThread.join();   // read() 한 번이 끝나야 빠진다 (최대 프레임 간격 한 번)
+    detThread.join();
+
+    band_udp_close(udp);
     ::close(sock);
     return 0;
 }
@@ -0,0 +1,105 @@
+#pragma once
+// 캡처 → 검출 → 화면 파이프라인용 단계 간 슬롯과 단계별 계측.
+//
+//   LatestSlot<T> : 깊이 1 슬롯. 생산자는 기다리지 않고 덮어쓰고(latest-frame-wins), 소비자는 새 값만 가져간다.
+//                   put/take 모두 swap 이라 버퍼 세 개(생산자/슬롯/소비자)가 돌아가며 재사용된다 (프레임마다 할당 없음).
+//   StageStats    : 단계별 처리 시간 평균/최대 + 건수. 보고 스레드가 take() 로 구간 값을 가져가며 리셋.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+template <class T>
+class LatestSlot
+{
+public:
+    // item 을 넣고 슬롯에 있던 것(소비자가 돌려준 빈 버퍼 또는 아직 안 가져간 이전 값)을 돌려받는다
+    void put(T &item)
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_mu);
+            using std::swap;
+            swap(m_item, item);
+            if (m_full) ++m_overwritten;   // 소비자가 못 따라온 값 하나를 버림
+            m_full = true;
+            ++m_put;
+        }
+        m_cv.notify_one();
+    }
+
+    // 새 값이 올 때까지 최대 timeout 기다린다. item 에 있던 버퍼는 슬롯으로 돌아간다
+    template <class Rep, class Period>
+    bool take(T &item, std::chrono::duration<Rep, Period> timeout)
+    {
+        std::unique_lock<std::mutex> lk(m_mu);
+        m_cv.wait_for(lk, timeout, [this] { return m_full || m_closed; });
+        if (!m_full) return false;
+        using std::swap;
+        swap(m_item, item);
+        m_full = false;
+        return true;
+    }
+
+    // 생산자가 끝났음을 알린다 (기다리는 take 를 깨움)
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_mu);
+            m_closed = true;
+        }
+        m_cv.notify_all();
+    }
+
+    bool closed() const { std::lock_guard<std::mutex> lk(m_mu); return m_closed && !m_full; }
+    int  depth() const { std::lock_guard<std::mutex> lk(m_mu); return m_full ? 1 : 0; }
+    uint64_t puts() const { std::lock_guard<std::mutex> lk(m_mu); return m_put; }
+    uint64_t overwritten() const { std::lock_guard<std::mutex> lk(m_mu); return m_overwritten; }
+
+private:
+    mutable std::mutex      m_mu;
+    std::condition_variable m_cv;
+    T        m_item{};
+    bool     m_full = false;
+    bool     m_closed = false;
+    uint64_t m_put = 0;
+    uint64_t m_overwritten = 0;
+};
+
+class StageStats
+{
+public:
+    struct Snapshot {
+        uint64_t n = 0;
+        double   avgMs = 0, maxMs = 0;
+    };
+
+    void add(std::chrono::steady_clock::duration d)
+    {
+        const int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+        std::lock_guard<std::mutex> lk(m_mu);
+        ++m_n;
+        m_sumUs += us;
+        m_maxUs = std::max(m_maxUs, us);
+    }
+
+    // 지난 take() 이후 구간
+    Snapshot take()
+    {
+        std::lock_guard<std::mutex> lk(m_mu);
+        Snapshot s;
+        s.n = m_n;
+        s.avgMs = m_n ? double(m_sumUs) / m_n / 1000.0 : 0.0;
+        s.maxMs = double(m_maxUs) / 1000.0;
+        m_n = 0; m_sumUs = 0; m_maxUs = 0;
+        return s;
+    }
+
+private:
+    std::mutex m_mu;
+    uint64_t   m_n = 0;
+    int64_t    m_sumUs = 0;
+    int64_t    m_maxUs = 0;
+};
@@ -0,0 +1,87 @@
+#pragma once
+// 패드 ROI 라벨 맵: 원/타원 ROI 를 시작할 때 한 번 8bit 맵으로 굳혀 두고,
+// 매 프레임 전경 마스크(pen)를 한 번만 훑어 패드별 겹침 픽셀 수를 히스토그램으로 센다.
+// (패드마다 bitwise_and + countNonZero 로 전체 프레임을 다섯 번 훑고 임시 Mat 다섯 개를 만들던 것 대체)
+//
+//   PadLabelMap labels(size);
+//   labels.addPad(mask0); labels.addPad(mask1); ...   // 패드 i = 비트 i (최대 8개)
+//   labels.count(pen, hits);                          // hits[i] = pen 과 패드 i 가 겹친 픽셀 수
+//
+// 값이 ID 가 아니라 비트인 이유: 패드끼리 가장자리가 겹쳐도 예전처럼 양쪽에 다 센다.
+// 패드를 더해도(하이햇, 라이드 ...) 프레임당 비용은 그대로 한 번 훑기 + 히스토그램 256칸 정리뿐이다.
+
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <cstring>
+
+// 한 행 누적: pen(0/255) & 라벨 → hist[값]++ (hist[0] = 배경, 버림).
+// 8픽셀씩 64bit 로 AND 하는 SWAR 루프 (x86/ARM 공통, OpenCV SIMD 버전 차이와 무관).
+// 전경이 없는 8픽셀(프레임 대부분)은 분기 하나로 건너뛰고, 있으면 8칸을 분기 없이 센다.
+// 연속 증가가 같은 칸에 몰릴 때의 저장→적재 지연을 줄이려고 히스토그램을 짝/홀 바이트 두 벌로 나눈다.
+static inline void padLabelHistRow(const uint8_t *pen, const uint8_t *lab, int n, uint32_t hist[2][256])
+{
+    int x = 0;
+    for (; x + 8 <= n; x += 8) {
+        uint64_t a, b;
+        std::memcpy(&a, pen + x, 8);
+        std::memcpy(&b, lab + x, 8);
+        const uint64_t w = a & b;
+        if (!w) continue;
+        ++hist[0][w & 0xff];         ++hist[1][(w >> 8) & 0xff];
+        ++hist[0][(w >> 16) & 0xff]; ++hist[1][(w >> 24) & 0xff];
+        ++hist[0][(w >> 32) & 0xff]; ++hist[1][(w >> 40) & 0xff];
+        ++hist[0][(w >> 48) & 0xff]; ++hist[1][w >> 56];
+    }
+    for (; x < n; ++x) ++hist[0][pen[x] & lab[x]];
+}
+
+class PadLabelMap
+{
+public:
+    static const int kMaxPads = 8;   // CV_8U 비트 수
+
+    explicit PadLabelMap(cv::Size size) : m_labels(cv::Mat::zeros(size, CV_8U)) {}
+
+    // 0 이 아닌 픽셀 = 패드 영역 (LINE_AA 가장자리 포함, countNonZero 와 같은 기준). 반환값: 패드 번호, 가득 차면 -1
+    int addPad(const cv::Mat &mask)
+    {
+        if (m_pads >= kMaxPads || mask.size() != m_labels.size() || mask.type() != CV_8U) return -1;
+        const int pad = m_pads++;
+        m_mask[pad] = uint8_t(1u << pad);
+        cv::bitwise_or(m_labels, cv::Scalar(m_mask[pad]), m_labels, mask);
+        m_area[pad] = cv::countNonZero(mask);
+        return pad;
+    }
+
+    int pads() const { return m_pads; }
+    int area(int pad) const { return m_area[pad]; }
+    const cv::Mat &labels() const { return m_labels; }
+
+    // pen: CV_8U 0/255 전경 마스크 (threshold 결과, 라벨 맵과 같은 크기). hits[0..pads()-1] 를 채운다
+    void count(const cv::Mat &pen, int hits[kMaxPads]) const
+    {
+        for (int i = 0; i < m_pads; ++i) hits[i] = 0;
+        if (pen.size() != m_labels.size() || pen.type() != CV_8U) return;
+
+        uint32_t hist[2][256] = {};
+        const bool flat = pen.isContinuous() && m_labels.isContinuous();
+        const int rows = flat ? 1 : pen.rows;
+        const int cols = flat ? pen.rows * pen.cols : pen.cols;
+        for (int y = 0; y < rows; ++y)
+            padLabelHistRow(pen.ptr<uint8_t>(y), m_labels.ptr<uint8_t>(y), cols, hist);
+
+        // 라벨 값(겹친 패드 비트 조합) → 패드별 합
+        for (int v = 1; v < 256; ++v) {
+            const uint32_t h = hist[0][v] + hist[1][v];
+            if (!h) continue;
+            for (int i = 0; i < m_pads; ++i)
+                if (v & m_mask[i]) hits[i] += int(h);
+        }
+    }
+
+private:
+    cv::Mat m_labels;
+    int     m_pads = 0;
+    int     m_area[kMaxPads] = {};
+    uint8_t m_mask[kMaxPads] = {};
+};
@@ -0,0 +1,142 @@
+// PadLabelMap (pad_labels.h) 테스트: 한 번 훑기 히스토그램 카운트가
+// 패드마다 bitwise_and + countNonZero 한 값(예전 경로)과 정확히 같은지 무작위 마스크로 비교한다.
+//   - LINE_AA 로 그려 가장자리 값이 1~254 인 원/타원 패드, 서로 겹치게 배치
+//   - 행 폭이 8의 배수가 아닌 크기 (SWAR 루프 뒤 꼬리 픽셀), 연속이 아닌 ROI Mat (행 단위 경로)
+//   - 전경이 촘촘한 프레임 / 드문 프레임 (8픽셀 건너뛰기)
+//
+// 사용법: make check  (또는 ./pad_labels_test, 실패가 있으면 종료 코드 1)
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <cstdio>
+
+#include "pad_labels.h"
+
+using namespace cv;
+
+static int g_failed = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { std::fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+
+// 드럼 화면처럼 겹치는 원 3개 + 타원 2개 (가장자리가 서로 걸치도록 반지름을 간격보다 크게)
+static void makePads(Size s, RNG &rng, std::vector<Mat> &masks)
+{
+    masks.clear();
+    const int r = std::max(4, s.width / 5);
+    for (int i = 0; i < 3; ++i) {
+        Mat m = Mat::zeros(s, CV_8U);
+        const Point c(s.width * (i + 1) / 4 + rng.uniform(-2, 3), s.height / 3 + rng.uniform(-2, 3));
+        circle(m, c, r, Scalar(255), FILLED, LINE_AA);
+        masks.push_back(m);
+    }
+    for (int i = 0; i < 2; ++i) {
+        Mat m = Mat::zeros(s, CV_8U);
+        const Point c(s.width * (2 * i + 1) / 4, s.height * 2 / 3);
+        ellipse(m, c, Size(r + 3, r / 2 + 2), rng.uniform(0, 180), 0, 360, Scalar(255), FILLED, LINE_AA);
+        masks.push_back(m);
+    }
+}
+
+// 0/255 전경: density 비율만큼 무작위 픽셀 + 작은 덩어리 몇 개 (threshold 결과처럼)
+static void makePen(Mat &pen, RNG &rng, double density)
+{
+    pen.setTo(Scalar(0));
+    const int n = int(pen.rows * pen.cols * density);
+    for (int i = 0; i < n; ++i) pen.at<uint8_t>(rng.uniform(0, pen.rows), rng.uniform(0, pen.cols)) = 255;
+    for (int i = 0; i < 3; ++i) {
+        const int w = rng.uniform(1, 12), h = rng.uniform(1, 12);
+        const int x = rng.uniform(0, std::max(1, pen.cols - w)), y = rng.uniform(0, std::max(1, pen.rows - h));
+        rectangle(pen, Rect(x, y, std::min(w, pen.cols - x), std::min(h, pen.rows - y)), Scalar(255), FILLED);
+    }
+}
+
+static void reference(const Mat &pen, const std::vector<Mat> &masks, int want[PadLabelMap::kMaxPads])
+{
+    Mat tmp;
+    for (size_t i = 0; i < masks.size(); ++i) {
+        bitwise_and(pen, masks[i], tmp);
+        want[i] = countNonZero(tmp);
+    }
+}
+
+static void compareOn(Size s, bool roi, uint64 seed)
+{
+    RNG rng(seed);
+    std::vector<Mat> masks;
+    makePads(s, rng, masks);
+
+    PadLabelMap map(s);
+    for (size_t i = 0; i < masks.size(); ++i) {
+        CHECK(map.addPad(masks[i]) == int(i));
+        CHECK(map.area(int(i)) == countNonZero(masks[i]));
+    }
+
+    // AA 가장자리가 실제로 있고 패드끼리 겹치는지 (픽스처 자체 확인)
+    Mat both;
+    bitwise_and(masks[0], masks[1], both);
+    CHECK(countNonZero(both) > 0);
+    int aa = 0;
+    for (int y = 0; y < s.height; ++y)
+        for (int x = 0; x < s.width; ++x) { const int v = masks[0].at<uint8_t>(y, x); aa += (v > 0 && v < 255); }
+    CHECK(aa > 0);
+
+    // roi: 더 큰 버퍼의 가운데를 잘라 써서 isContinuous() == false 인 경로
+    Mat big(s.height + 4, s.width + 13, CV_8U, Scalar(255));
+    Mat pen = roi ? big(Rect(5, 2, s.width, s.height)) : Mat(s, CV_8U);
+    CHECK(pen.isContinuous() == !roi);
+
+    const double densities[] = { 0.0, 0.002, 0.05, 0.5, 1.0 };
+    for (double d : densities) {
+        for (int rep = 0; rep < 4; ++rep) {
+            makePen(pen, rng, d);
+            int got[PadLabelMap::kMaxPads], want[PadLabelMap::kMaxPads];
+            map.count(pen, got);
+            reference(pen, masks, want);
+            for (int i = 0; i < map.pads(); ++i) {
+                if (got[i] != want[i]) {
+                    std::fprintf(stderr, "  %dx%d roi=%d density=%.3f pad %d: got %d want %d\n",
+                                 s.width, s.height, int(roi), d, i, got[i], want[i]);
+                }
+                CHECK(got[i] == want[i]);
+            }
+        }
+    }
+}
+
+// 8개까지만 (CV_8U 비트 수), 크기/형식이 다른 마스크는 거절
+static void testLimits()
+{
+    const Size s(37, 21);
+    PadLabelMap map(s);
+    Mat m = Mat::zeros(s, CV_8U);
+    circle(m, Point(18, 10), 6, Scalar(255), FILLED, LINE_AA);
+    for (int i = 0; i < PadLabelMap::kMaxPads; ++i) CHECK(map.addPad(m) == i);
+    CHECK(map.addPad(m) == -1);
+    CHECK(PadLabelMap(s).addPad(Mat::zeros(Size(36, 21), CV_8U)) == -1);
+
+    // 모든 패드가 같은 영역 → 라벨 0xFF, 겹친 픽셀은 8개 패드 모두에 센다
+    Mat pen(s, CV_8U, Scalar(255));
+    int hits[PadLabelMap::kMaxPads];
+    map.count(pen, hits);
+    for (int i = 0; i < PadLabelMap::kMaxPads; ++i) CHECK(hits[i] == countNonZero(m));
+
+    // 크기가 다른 pen → 전부 0
+    map.count(Mat(Size(36, 21), CV_8U, Scalar(255)), hits);
+    for (int i = 0; i < PadLabelMap::kMaxPads; ++i) CHECK(hits[i] == 0);
+}
+
+int main()
+{
+    const Size sizes[] = { Size(320, 180), Size(163, 91), Size(101, 57), Size(7, 5) };   // 8의 배수가 아닌 폭 포함
+    uint64 seed = 12345;
+    for (const Size &s : sizes) {
+        compareOn(s, false, seed++);
+        compareOn(s, true, seed++);
+    }
+    testLimits();
+    if (g_failed) { std::fprintf(stderr, "pad_labels_test: %d check(s) failed\n", g_failed); return 1; }
+    std::printf("pad_labels_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,216 @@
+#pragma once
+// 스틱 끝 추적 + 패드 접촉 예측 (예측 온셋).
+// 전경 마스크의 연결 요소(손+스틱 덩어리)를 프레임 사이에 최근접으로 이어 트랙을 만들고,
+// 덩어리에서 이동 방향으로 가장 앞선 픽셀들을 스틱 끝으로 본다. 끝의 속도로 다음 프레임 위치를 외삽해
+// 그 자리가 패드 안이면 "다음 프레임에 닿는다"로 보고 이번 프레임에 울린다.
+// 겹침 비율 히스테리시스(2프레임 연속)보다 최대 두 프레임 빠르고, 닿기 직전 속도를 세기(velocity)로 쓴다.
+//
+//   StickTracker sticks(padMap, minArea, maxArea);
+//   sticks.update(pen, tSec, onsets);      // onsets[i] = { 패드, velocity 1~127, 예측 여부 }
+//
+// 한 진입에 한 번만 울린다: 끝이 패드 밖으로 나가고 다음 프레임 예측도 밖이어야 그 패드가 다시 장전된다.
+// 쿨다운과 히스테리시스 경로와의 중복 억제는 호출한 쪽(PadDetector)이 패드 단위로 한다.
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "pad_labels.h"
+
+struct StickOnset {
+    int  pad;
+    int  velocity;     // 1~127
+    bool predicted;    // true = 닿기 한 프레임 전에 울림, false = 이번 프레임에 끝이 패드 안으로 들어옴
+};
+
+class StickTracker
+{
+public:
+    static constexpr int kMaxTracks   = 4;      // 스틱 둘 + 여유
+    static constexpr int kMaxBlobs    = 8;      // 프레임당 보는 덩어리 수 (큰 것부터)
+    static constexpr int kLostFrames  = 2;      // 이만큼 연속으로 못 찾으면 트랙을 버린다
+    static constexpr int kMinVelocity = 16;
+    static constexpr float  kFullSpeed = 4.0f;    // 처리 폭/초. 이 속도 이상이면 velocity 127
+    static constexpr float  kMinSpeed  = 0.6f;    // 처리 폭/초. 더 느린 움직임(손 얹어 두기 등)은 타격으로 안 본다
+    static constexpr float  kGate      = 0.2f;    // 처리 폭 비율. 한 프레임 사이 이보다 멀리 간 덩어리는 다른 물체
+    static constexpr float  kTipBand   = 2.0f;    // px. 가장 앞선 픽셀에서 이 안쪽까지 평균해 끝 위치 잡음을 줄인다
+    static constexpr double kMaxGapSec = 0.25;    // 프레임 간격이 이보다 벌어지면(끊김) 트랙을 새로 시작
+
+    struct Track {
+        cv::Point2f c, tip;       // 덩어리 중심, 스틱 끝 (px)
+        cv::Point2f vc, vt;       // 각각의 속도 (px/s, 두 프레임 평균)
+        double  t = 0;            // 마지막으로 이어 붙은 프레임 시각
+        float   speed = 0;        // |vt| / 처리 폭 (폭/초)
+        int     age = 0;          // 이어 붙은 프레임 수 (2 이상부터 끝 속도가 의미 있다)
+        int     lost = 0;
+        uint8_t bits = 0;         // 지금 끝이 올라가 있는 패드 비트
+        uint8_t fired = 0;        // 이번 진입에서 이미 울린 패드 비트
+    };
+
+    StickTracker(const PadLabelMap &map, int minArea, int maxArea)
+        : m_map(map), m_minArea(minArea), m_maxArea(maxArea) {}
+
+    // pen: CV_8U 0/255 전경 마스크 (라벨 맵 크기), t: 프레임 시각 (초, 단조)
+    void update(const cv::Mat &pen, double t, std::vector<StickOnset> &out)
+    {
+        out.clear();
+        const double dt = t - m_lastT;
+        if (m_lastT < 0 || dt <= 0 || dt > kMaxGapSec) m_tracks.clear();
+        m_lastT = t;
+        m_frameDt = float(dt);
+
+        const int n = cv::connectedComponentsWithStats(pen, m_cc, m_stats, m_cent, 8, CV_32S);
+        m_blobs.clear();
+        for (int k = 1; k < n; ++k) {
+            const int area = m_stats.at<int>(k, cv::CC_STAT_AREA);
+            if (area < m_minArea || area > m_maxArea) continue;
+            m_blobs.push_back({ k, area, cv::Point2f(float(m_cent.at<double>(k, 0)), float(m_cent.at<double>(k, 1))) });
+        }
+        std::sort(m_blobs.begin(), m_blobs.end(), [](const Blob &a, const Blob &b) { return a.area > b.area; });
+        if (m_blobs.size() > size_t(kMaxBlobs)) m_blobs.resize(kMaxBlobs);
+
+        // 트랙 예측 중심 ↔ 덩어리 중심, 가까운 쌍부터 한 번씩 (둘 다 몇 개뿐이라 전부 비교)
+        const float gate = kGate * pen.cols;
+        m_pairs.clear();
+        for (size_t i = 0; i < m_tracks.size(); ++i) {
+            const cv::Point2f pred = m_tracks[i].c + m_tracks[i].vc * float(t - m_tracks[i].t);
+            for (size_t j = 0; j < m_blobs.size(); ++j) {
+                const cv::Point2f d = m_blobs[j].c - pred;
+                const float d2 = d.dot(d);
+                if (d2 <= gate * gate) m_pairs.push_back({ d2, int(i), int(j) });
+            }
+        }
+        std::sort(m_pairs.begin(), m_pairs.end(), [](const Pair &a, const Pair &b) { return a.d2 < b.d2; });
+
+        std::vector<char> trackUsed(m_tracks.size(), 0), blobUsed(m_blobs.size(), 0);
+        for (const Pair &p : m_pairs) {
+            if (trackUsed[p.track] || blobUsed[p.blob]) continue;
+            trackUsed[p.track] = blobUsed[p.blob] = 1;
+            advance(m_tracks[p.track], m_blobs[p.blob], t, out);
+        }
+        for (size_t i = 0; i < m_tracks.size(); ++i)
+            if (!trackUsed[i]) ++m_tracks[i].lost;
+        m_tracks.erase(std::remove_if(m_tracks.begin(), m_tracks.end(),
+                                      [](const Track &tr) { return tr.lost > kLostFrames; }),
+                       m_tracks.end());
+
+        // 새 덩어리 = 새 트랙. 속도가 없으니 이번 프레임엔 울리지 않는다
+        for (size_t j = 0; j < m_blobs.size() && m_tracks.size() < size_t(kMaxTracks); ++j) {
+            if (blobUsed[j]) continue;
+            Track tr;
+            tr.c = tr.tip = m_blobs[j].c;
+            tr.t = t;
+            tr.bits = bitsAt(tr.tip);
+            m_tracks.push_back(tr);
+        }
+    }
+
+    // 끝이 이 패드 위에 있는 트랙 중 가장 빠른 것의 velocity (없으면 0 = 기본 세기).
+    // 예측이 놓친 타격을 히스테리시스가 울릴 때 쓴다
+    int velocityFor(int pad) const
+    {
+        float best = -1;
+        for (const Track &tr : m_tracks)
+            if (tr.age >= 2 && (tr.bits & (1u << pad))) best = std::max(best, tr.speed);
+        return best < 0 ? 0 : velocityOf(best);
+    }
+
+    const std::vector<Track> &tracks() const { return m_tracks; }
+
+    static int velocityOf(float speed)
+    {
+        const int v = int(127.f * speed / kFullSpeed + 0.5f);
+        return std::max(kMinVelocity, std::min(127, v));
+    }
+
+private:
+    struct Blob { int label, area; cv::Point2f c; };
+    struct Pair { float d2; int track, blob; };
+
+    uint8_t bitsAt(cv::Point2f p) const
+    {
+        const cv::Mat &lab = m_map.labels();
+        const int x = std::max(0, std::min(lab.cols - 1, int(std::lround(p.x))));
+        const int y = std::max(0, std::min(lab.rows - 1, int(std::lround(p.y))));
+        return lab.at<uint8_t>(y, x);
+    }
+
+    // 덩어리에서 dir 쪽으로 가장 앞선 픽셀들의 평균 (dir 이 거의 0 이면 중심)
+    cv::Point2f tipOf(const Blob &b, cv::Point2f dir) const
+    {
+        const float len = std::sqrt(dir.dot(dir));
+        if (len < 1e-3f) return b.c;
+        dir *= 1.f / len;
+
+        const int x0 = m_stats.at<int>(b.label, cv::CC_STAT_LEFT), y0 = m_stats.at<int>(b.label, cv::CC_STAT_TOP);
+        const int x1 = x0 + m_stats.at<int>(b.label, cv::CC_STAT_WIDTH), y1 = y0 + m_stats.at<int>(b.label, cv::CC_STAT_HEIGHT);
+        float best = -1e30f;
+        for (int y = y0; y < y1; ++y) {
+            const int *row = m_cc.ptr<int>(y);
+            for (int x = x0; x < x1; ++x)
+                if (row[x] == b.label) best = std::max(best, x * dir.x + y * dir.y);
+        }
+        cv::Point2f sum(0, 0);
+        int cnt = 0;
+        for (int y = y0; y < y1; ++y) {
+            const int *row = m_cc.ptr<int>(y);
+            for (int x = x0; x < x1; ++x)
+                if (row[x] == b.label && x * dir.x + y * dir.y >= best - kTipBand) { sum += cv::Point2f(float(x), float(y)); ++cnt; }
+        }
+        return cnt ? sum * (1.f / cnt) : b.c;
+    }
+
+    // dt 는 이 트랙 기준 (놓쳤던 프레임이 있으면 그만큼 길다). 다음 프레임은 지난 프레임 간격 뒤로 본다
+    void advance(Track &tr, const Blob &b, double t, std::vector<StickOnset> &out)
+    {
+        const float dt = float(t - tr.t), inv = 1.f / dt;
+        const cv::Point2f vc = (b.c - tr.c) * inv;
+        // 방향이 뒤집히면(타격 뒤 들어 올림) 끝이 덩어리 반대편으로 옮겨 가므로 끝 속도를 새로 잰다
+        const bool reversed = tr.age && tr.vc.dot(vc) < 0;
+        tr.vc = (tr.age && !reversed) ? (tr.vc + vc) * 0.5f : vc;
+        tr.c  = b.c;
+        tr.t  = t;
+
+        const cv::Point2f tip = tipOf(b, tr.vc);
+        const cv::Point2f vt = (tip - tr.tip) * inv;
+        tr.vt   = (reversed || !tr.age) ? tr.vc : (tr.vt + vt) * 0.5f;   // 직전 끝이 다른 기준(중심/반대편)이면 중심 속도로
+        tr.tip  = tip;
+        tr.lost = 0;
+        tr.age  = reversed ? 1 : tr.age + 1;
+        tr.speed = std::sqrt(tr.vt.dot(tr.vt)) / float(m_map.labels().cols);
+
+        // 다음 프레임 끝 위치 (중간 지점도 봐서 한 프레임에 패드 가장자리를 건너뛰는 빠른 타격도 잡는다)
+        const uint8_t prev  = tr.bits;
+        const uint8_t now   = bitsAt(tip);
+        const uint8_t ahead = bitsAt(tip + tr.vt * (0.5f * m_frameDt)) | bitsAt(tip + tr.vt * m_frameDt);
+        tr.bits = now;
+
+        if (tr.age >= 2 && tr.speed >= kMinSpeed) {
+            const int vel = velocityOf(tr.speed);
+            for (int pad = 0; pad < m_map.pads(); ++pad) {
+                const uint8_t bit = uint8_t(1u << pad);
+                if (tr.fired & bit) continue;
+                if ((now & bit) && !(prev & bit)) {          // 예측은 놓쳤지만 이번 프레임에 들어옴
+                    out.push_back({ pad, vel, false });
+                    tr.fired |= bit;
+                } else if (!(now & bit) && (ahead & bit)) {  // 다음 프레임에 닿는다
+                    out.push_back({ pad, vel, true });
+                    tr.fired |= bit;
+                }
+            }
+        }
+        tr.fired &= uint8_t(now | ahead);   // 밖으로 나갔고 다음 예측도 밖인 패드는 다시 장전
+    }
+
+    const PadLabelMap &m_map;
+    int     m_minArea, m_maxArea;
+    double  m_lastT = -1;
+    float   m_frameDt = 0;
+    cv::Mat m_cc, m_stats, m_cent;
+    std::vector<Blob>  m_blobs;
+    std::vector<Pair>  m_pairs;
+    std::vector<Track> m_tracks;
+};
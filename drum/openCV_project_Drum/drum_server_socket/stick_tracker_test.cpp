@@ -0,0 +1,176 @@
+// StickTracker (stick_tracker.h) 테스트: 합성 전경 마스크로 예측 온셋 동작을 확인한다.
+//   - 패드로 내려치는 스틱은 끝이 패드에 처음 닿는 프레임의 한 프레임 전에 울린다 (predicted)
+//   - 패드 안으로 천천히 들어오는 스틱, 패드 위에 얹어 두고 살짝 흔들리는 손은 울리지 않는다
+//   - 한 진입에 한 번만 울리고, 들어 올렸다가 다시 치면 또 울린다
+//   - 더 빠르게 친 타격이 더 큰 velocity
+//
+// 사용법: make check  (또는 ./stick_tracker_test, 실패가 있으면 종료 코드 1)
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <cstdio>
+#include <vector>
+
+#include "pad_labels.h"
+#include "stick_tracker.h"
+
+using namespace cv;
+
+static int g_failed = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { std::fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); ++g_failed; } \
+} while (0)
+
+// 320x180 처리 프레임, 가운데 아래에 원 패드 하나 (윗가장자리 y=90), 30 fps
+static const Size   kSize(320, 180);
+static const Point  kPadCenter(160, 120);
+static const int    kPadRadius = 30;
+static const double kFrameSec  = 1.0 / 30;
+
+struct Scene {
+    Mat         padMask;
+    PadLabelMap map;
+    Scene() : padMask(Mat::zeros(kSize, CV_8U)), map(kSize)
+    {
+        circle(padMask, kPadCenter, kPadRadius, Scalar(255), FILLED, LINE_AA);
+        map.addPad(padMask);
+    }
+};
+
+// 프레임마다 전경 사각형 하나 (스틱/손). 프레임별 온셋과 패드에 실제로 닿았는지를 돌려준다
+struct Frame {
+    std::vector<StickOnset> onsets;
+    bool touching = false;
+};
+
+static std::vector<Frame> run(Scene &sc, const std::vector<Rect> &rects)
+{
+    StickTracker sticks(sc.map, 20, 20000);
+    std::vector<Frame> frames(rects.size());
+    Mat pen(kSize, CV_8U), both;
+    for (size_t i = 0; i < rects.size(); ++i) {
+        pen.setTo(Scalar(0));
+        rectangle(pen, rects[i], Scalar(255), FILLED);
+        bitwise_and(pen, sc.padMask, both);
+        frames[i].touching = countNonZero(both) > 0;
+        sticks.update(pen, 1.0 + i * kFrameSec, frames[i].onsets);
+    }
+    return frames;
+}
+
+// 6x40 스틱을 위에서 step px/프레임으로 내려 패드를 치고, 잠깐 멈췄다가 같은 속도로 들어 올린다
+static void strike(std::vector<Rect> &rects, int step)
+{
+    int bottom = 24;
+    while (bottom < 96) { rects.push_back(Rect(157, bottom - 40, 6, 40)); bottom += step; }
+    rects.push_back(Rect(157, 96 - 40, 6, 40));   // 닿은 프레임 (윗가장자리에서 6px 안)
+    rects.push_back(Rect(157, 96 - 40, 6, 40));
+    rects.push_back(Rect(157, 96 - 40, 6, 40));
+    for (bottom = 96 - step; bottom > 24; bottom -= step) rects.push_back(Rect(157, bottom - 40, 6, 40));
+}
+
+static int firstTouch(const std::vector<Frame> &f, size_t from = 0)
+{
+    for (size_t i = from; i < f.size(); ++i) if (f[i].touching) return int(i);
+    return -1;
+}
+
+static int onsetCount(const std::vector<Frame> &f, size_t from = 0, size_t to = size_t(-1))
+{
+    int n = 0;
+    for (size_t i = from; i < f.size() && i < to; ++i) n += int(f[i].onsets.size());
+    return n;
+}
+
+// 내려치기: 닿기 한 프레임 전에 예측으로 한 번, 닿은 프레임/머무는 동안/들어 올릴 때는 없음
+static void testFiresBeforeContact()
+{
+    Scene sc;
+    std::vector<Rect> rects;
+    strike(rects, 12);
+    const std::vector<Frame> f = run(sc, rects);
+
+    const int touch = firstTouch(f);
+    CHECK(touch >= 3);
+    if (touch < 1) return;
+    CHECK(f[touch - 1].onsets.size() == 1);
+    if (f[touch - 1].onsets.size() == 1) {
+        const StickOnset &o = f[touch - 1].onsets[0];
+        CHECK(o.pad == 0);
+        CHECK(o.predicted);
+        CHECK(o.velocity >= StickTracker::kMinVelocity && o.velocity <= 127);
+    }
+    CHECK(!f[touch - 1].touching);
+    CHECK(onsetCount(f) == 1);
+}
+
+// 패드 안으로 천천히 미는 스틱 (2 px/프레임 = 0.19 폭/초 < kMinSpeed)
+static void testIgnoresSlowDrift()
+{
+    Scene sc;
+    std::vector<Rect> rects;
+    for (int bottom = 60; bottom <= 130; bottom += 2) rects.push_back(Rect(157, bottom - 40, 6, 40));
+    const std::vector<Frame> f = run(sc, rects);
+    CHECK(firstTouch(f) > 0);
+    CHECK(onsetCount(f) == 0);
+}
+
+// 패드 위에 얹어 둔 손: 처음부터 패드 위에 있고 1px 씩 흔들린다
+static void testIgnoresRestingHand()
+{
+    Scene sc;
+    std::vector<Rect> rects;
+    static const int jitter[] = { 0, 1, 0, -1, 1, 1, 0, -1, -1, 0 };
+    for (int i = 0; i < 40; ++i) rects.push_back(Rect(140 + jitter[i % 10], 100 + jitter[(i + 3) % 10], 40, 30));
+    const std::vector<Frame> f = run(sc, rects);
+    CHECK(firstTouch(f) == 0);
+    CHECK(onsetCount(f) == 0);
+}
+
+// 두 번 치면 두 번, 진입마다 한 번 (머무는 동안 다시 울리지 않음)
+static void testOncePerEntry()
+{
+    Scene sc;
+    std::vector<Rect> rects;
+    strike(rects, 12);
+    const size_t second = rects.size();
+    strike(rects, 12);
+    const std::vector<Frame> f = run(sc, rects);
+
+    const int t1 = firstTouch(f), t2 = firstTouch(f, second);
+    CHECK(t1 > 0 && t2 > int(second));
+    if (t1 <= 0 || t2 <= int(second)) return;
+    CHECK(f[t1 - 1].onsets.size() == 1);
+    CHECK(f[t2 - 1].onsets.size() == 1);
+    CHECK(onsetCount(f, 0, second) == 1);
+    CHECK(onsetCount(f, second) == 1);
+}
+
+// 같은 자리에서 빠르게 친 타격이 더 세다
+static void testVelocityFollowsSpeed()
+{
+    int vel[2] = { 0, 0 };
+    const int steps[2] = { 8, 16 };
+    for (int k = 0; k < 2; ++k) {
+        Scene sc;
+        std::vector<Rect> rects;
+        strike(rects, steps[k]);
+        const std::vector<Frame> f = run(sc, rects);
+        for (const Frame &fr : f) for (const StickOnset &o : fr.onsets) vel[k] = o.velocity;
+        CHECK(onsetCount(f) == 1);
+    }
+    CHECK(vel[0] > 0 && vel[1] > vel[0]);
+}
+
+int main()
+{
+    testFiresBeforeContact();
+    testIgnoresSlowDrift();
+    testIgnoresRestingHand();
+    testOncePerEntry();
+    testVelocityFollowsSpeed();
+    if (g_failed) { std::fprintf(stderr, "stick_tracker_test: %d check(s) failed\n", g_failed); return 1; }
+    std::printf("stick_tracker_test: OK\n");
+    return 0;
+}
@@ -15,6 +15,11 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 
+#include "band_capture.h"
+#include "band_protocol.h"
+#include "band_udp.h"
+#include "band_session.h"
+
 using namespace cv;
 using namespace std;
 
@@ -23,6 +28,12 @@ static string SERVER_IP   = "127.0.0.1";
 static int    SERVER_PORT = 5000;
 static string CLIENT_ID   = "GUITA";
 static string CLIENT_PW   = "PASSWD";
+static bool   USE_BINARY  = false;   // BAND_PROTO=bin 이면 바이너리 레코드 전송
+static uint32_t g_seq     = 0;       // 이벤트 순번 (재접속해도 계속 증가)
+static bool   USE_UDP     = false;   // BAND_PROTO=udp 이면 노트는 UDP, 로그인/제어는 TCP
+static BandUdpLink g_udp;
+static string g_session;             // 서버가 로그인 때 준 세션 토큰 (재접속 시 RESUME)
+static bool   g_resumed   = false;   // 마지막 접속이 세션 재개였는지
 
 // ====== 카메라 설정 ======
 static const vector<int> PREFERRED_INDEXES = {1, 2, 0}; // 당신 환경: 1,2가 실제 캠, 0은 Iriun
@@ -88,7 +99,7 @@ static double now_sec() {
 // -----------------------------------------------
 // TCP 클라이언트
 // -----------------------------------------------
-static int tcp_connect_and_login(const string& ip, int port, const string& id, const string& pw) {
+static int tcp_connect(const string& ip, int port) {
     int sock = ::socket(AF_INET, SOCK_STREAM, 0);
     if (sock < 0) {
         perror("[ERR] socket");
@@ -105,6 +116,25 @@ static int tcp_connect_and_login(const string& ip, int port, const string& id, c
         close(sock);
         return -1;
     }
+    return sock;
+}
+
+static int tcp_connect_and_login(const string& ip, int port, const string& id, const string& pw) {
+    int sock = tcp_connect(ip, port);
+    if (sock < 0) return -1;
+
+    // 재접속: 세션 토큰 한 줄로 ID/프로토콜 모드/seq/UDP key 복원 (로그인·협상 왕복 없음)
+    g_resumed = false;
+    if (!g_session.empty()) {
+        if (band_session_resume(sock, g_session)) {
+            g_resumed = true;
+            cout << "[NET] Session resumed for ID=" << id << endl;
+            return sock;
+        }
+        cerr << "[WARN] 세션 재개 실패 → 로그인부터 다시" << endl;
+        g_session.clear();
+        band_udp_close(g_udp);   // 이전 UDP key 는 무효
+    }
 
     // 서버는 최초에 "id:pw" 를 읽어 인증
     string login = id + ":" + pw + "\n";
@@ -115,10 +145,48 @@ static int tcp_connect_and_login(const string& ip, int port, const string& id, c
         return -1;
     }
     cout << "[NET] Connected & sent login for ID=" << id << endl;
+    if (!band_session_wait(sock, g_session))
+        cerr << "[WARN] 세션 토큰 없음 (옛 서버?) → 재접속 시 다시 로그인" << endl;
+
+    // 바이너리 프로토콜 협상 (응답은 기다리지 않음 — 서버는 이 줄 다음 바이트부터 레코드로 해석)
+    if (USE_BINARY) {
+        const char *hello = BAND_PROTO_HELLO_BIN;
+        if (send(sock, hello, strlen(hello), 0) <= 0) {
+            perror("[ERR] send(proto hello)");
+            close(sock);
+            return -1;
+        }
+        cout << "[NET] binary protocol requested" << endl;
+    }
+    // UDP 이벤트 채널 (서버가 응답하지 않으면 TCP 텍스트로 계속)
+    if (USE_UDP && !band_udp_open(sock, ip, g_udp))
+        cerr << "[WARN] UDP 채널 실패 → TCP 로 전송" << endl;
     return sock;
 }
 
-static bool tcp_send_guita(int sock, const string& label_one_char /* "G"|"D"|"C" */) {
+// frameUs: 이 타격을 판정한 카메라 프레임 시각 (band_now_us 축). 서버는 이 값으로 도착 지연을 잰다
+static bool tcp_send_guita(int sock, const string& label_one_char /* "G"|"D"|"C" */, uint64_t frameUs) {
+    if (g_udp.ok()) {
+        const int note = band_note_from_char(BAND_INST_GUITA, label_one_char[0]);
+        if (note < 0) return true;
+        // UDP 는 재전송 대기가 없다. 실패해도 TCP 재접속 대상은 아님
+        if (!band_udp_send(g_udp, BAND_INST_GUITA, uint8_t(note), BAND_VELOCITY_DEFAULT, frameUs))
+            perror("[WARN] send(udp)");
+        return true;
+    }
+    if (USE_BINARY) {
+        const int note = band_note_from_char(BAND_INST_GUITA, label_one_char[0]);
+        if (note < 0) return true;   // 매핑 없는 라벨은 무시
+        BandEventRecord rec = band_make_event(BAND_INST_GUITA, uint8_t(note), BAND_VELOCITY_DEFAULT,
+                                              ++g_seq, frameUs);
+        ssize_t n = send(sock, &rec, sizeof(rec), 0);
+        if (n != (ssize_t)sizeof(rec)) {
+            perror("[ERR] send(record)");
+            return false;
+        }
+        return true;
+    }
+
     // 서버 파서가 "[:]" 를 구분자로 쓰므로, "[GUITA]G\n" 형태가 안전
     string msg = "[GUITA]" + label_one_char + "\n";
     ssize_t n = send(sock, msg.c_str(), (int)msg.size(), 0);
@@ -138,6 +206,8 @@ int main(int argc, char** argv) {
     if (argc >= 3) SERVER_PORT = atoi(argv[2]);
     if (argc >= 4) CLIENT_ID   = argv[3];
     if (argc >= 5) CLIENT_PW   = argv[4];
+    USE_BINARY = band_binary_requested();
+    USE_UDP    = band_udp_requested();
 
     // ---- 서버 접속 & 로그인 ----
     int sock = tcp_connect_and_login(SERVER_IP, SERVER_PORT, CLIENT_ID, CLIENT_PW);
@@ -156,9 +226,20 @@ int main(int argc, char** argv) {
     }
     cout << "[OK] Using /dev/video" << used_idx << endl;
 
-    cap.set(CAP_PROP_FRAME_WIDTH,  REQ_W);
-    cap.set(CAP_PROP_FRAME_HEIGHT, REQ_H);
-    cap.set(CAP_PROP_FPS,          REQ_FPS);
+    // BAND_CAPTURE=fast 면 같은 장치를 최고 fps 모드로 다시 연다 (존 판정이 거칠어지지 않게 폭 640 이상).
+    // 프레임 시각은 드라이버 버퍼 시각이 되어 전송 로그의 지연이 촬상 직후부터 잰 값이 된다
+    BandCaptureFormat capFmt;
+    bool fastCap = false;
+    if (band_fast_capture_requested()) {
+        cap.release();
+        fastCap = band_capture_open_fast(cap, "/dev/video" + to_string(used_idx), capFmt, 640);
+        if (!fastCap) cap.open(used_idx, CAP_V4L2);
+    }
+    if (!fastCap) {
+        cap.set(CAP_PROP_FRAME_WIDTH,  REQ_W);
+        cap.set(CAP_PROP_FRAME_HEIGHT, REQ_H);
+        cap.set(CAP_PROP_FPS,          REQ_FPS);
+    }
 
     int W = (int)cap.get(CAP_PROP_FRAME_WIDTH);
     int H = (int)cap.get(CAP_PROP_FRAME_HEIGHT);
@@ -185,6 +266,8 @@ int main(int argc, char** argv) {
             waitKey(20);
             continue;
         }
+        // 이 프레임의 시각 (고속 캡처면 드라이버 시각, 아니면 read() 반환 시각)
+        const uint64_t frame_us = fastCap ? band_capture_frame_us(cap, band_now_us()) : band_now_us();
 
         Mat gray_full; cvtColor(frame, gray_full, COLOR_BGR2GRAY);
         GaussianBlur(gray_full, gray_full, Size(5,5), 0);
@@ -232,22 +315,27 @@ int main(int argc, char** argv) {
                 putText(frame, "TRIGGER " + ZONE_LABELS[i], Point(r.x+12, r.y+66),
                         FONT_HERSHEY_SIMPLEX, 0.9, Scalar(0,215,255), 2);
 
-                if (!tcp_send_guita(sock, ZONE_LABELS[i])) {
+                if (!tcp_send_guita(sock, ZONE_LABELS[i], frame_us)) {
                     cerr << "[WARN] 서버 전송 실패. 재접속 시도…" << endl;
+                    const uint64_t t0 = band_now_us();
                     close(sock);
                     sock = tcp_connect_and_login(SERVER_IP, SERVER_PORT, CLIENT_ID, CLIENT_PW);
                     if (sock >= 0) {
                         // 재접속 성공 시 한번 더 시도(실패해도 진행)
-                        tcp_send_guita(sock, ZONE_LABELS[i]);
+                        tcp_send_guita(sock, ZONE_LABELS[i], frame_us);
+                        cout << "[NET] reconnect -> first note " << (band_now_us() - t0) / 1000.0 << " ms ("
+                             << (g_resumed ? "resume" : "login") << ")" << endl;
                     }
                 } else {
-                    cout << "[NET] Sent: [GUITA]" << ZONE_LABELS[i] << endl;
+                    cout << "[NET] Sent: [GUITA]" << ZONE_LABELS[i] << "  frame->send "
+                         << (band_now_us() - frame_us) / 1000.0 << " ms" << (fastCap ? " (driver ts)" : "") << endl;
                 }
             }
         }
 
         // 하단 정보
         string info1 = "/dev/video" + to_string(used_idx) + "  " + to_string(W) + "x" + to_string(H) +
+                       (fastCap ? "  " + band_fourcc_str(capFmt.fourcc) + "@" + to_string(int(capFmt.fps + 0.5)) : string()) +
                        "  cooldown=" + to_string(COOLDOWN_SEC).substr(0,4) + "s";
         string info2 = "thr=" + to_string(MOTION_AREA_THR).substr(0,6) + "  bin_thr=" + to_string(MOTION_BIN_THR);
         putText(frame, info1, Point(10, H-40), FONT_HERSHEY_SIMPLEX, 0.8, Scalar(50,230,50), 2);
@@ -16,16 +16,22 @@ HandDetector::HandDetector()
 }
 
 bool HandDetector::initialize() {
+    // BAND_CAPTURE=fast 면 최고 fps 모드 (건반 판정용으로 폭 640 이상), 실패하면 기존 방식
+    if (band_fast_capture_requested())
+        fastCapture_ = band_capture_open_fast(cap_, "/dev/video0", capFormat_, 640);
+
     // 웹캠 초기화
-    cap_.open(0);
+    if (!fastCapture_) cap_.open(0);
     if (!cap_.isOpened()) {
         std::cerr << "Error: Could not open webcam" << std::endl;
         return false;
     }
     
     // 웹캠 해상도 설정
-    cap_.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-    cap_.set(cv::CAP_PROP_FRAME_HEIGHT, 480);
+    if (!fastCapture_) {
+        cap_.set(cv::CAP_PROP_FRAME_WIDTH, 640);
+        cap_.set(cv::CAP_PROP_FRAME_HEIGHT, 480);
+    }
     
     std::cout << "Webcam initialized successfully" << std::endl;
     return true;
@@ -36,6 +42,7 @@ void HandDetector::processFrame(cv::Mat& frame) {
     
     cap_ >> frame;
     if (frame.empty()) return;
+    frameUs_ = fastCapture_ ? band_capture_frame_us(cap_, band_now_us()) : band_now_us();
     
     // 배경 캡처 (첫 번째 프레임)
     if (!backgroundCaptured_) {
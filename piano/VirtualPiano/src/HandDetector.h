@@ -1,8 +1,11 @@
 #pragma once
 
 #include <opencv2/opencv.hpp>
+#include <cstdint>
 #include <vector>
 
+#include "band_capture.h"
+
 struct FingerPoint {
     cv::Point2f position;
     bool isActive;
@@ -19,6 +22,10 @@ public:
     std::vector<FingerPoint> getFingerPoints() const { return fingerPoints_; }
     
     void setKeyPositions(const std::vector<cv::Rect>& keyRects);
+
+    // 마지막 프레임 시각 (band_now_us 축). BAND_CAPTURE=fast 면 드라이버 버퍼 시각, 아니면 read 반환 시각
+    uint64_t frameTimeUs() const { return frameUs_; }
+    bool fastCapture() const { return fastCapture_; }
     
     // 디버그용 함수
     void drawDebugInfo(cv::Mat& frame);
@@ -26,6 +33,9 @@ public:
 
 private:
     cv::VideoCapture cap_;
+    BandCaptureFormat capFormat_;
+    bool fastCapture_ = false;
+    uint64_t frameUs_ = 0;
     std::vector<FingerPoint> fingerPoints_;
     std::vector<cv::Rect> keyRects_;
     
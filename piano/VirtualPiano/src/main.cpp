@@ -17,6 +17,8 @@
 // 기존 프로젝트 헤더 (OpenCV 피아노 UI, 손 검출)
 #include "OpenCVPiano.h"
 #include "HandDetector.h"
+#include "band_protocol.h"
+#include "band_udp.h"
 
 // -----------------------------
 // 간단한 TCP 송신 헬퍼
@@ -53,9 +55,13 @@ public:
     }
 
     bool sendLine(const std::string& s) {
+        return sendBytes(s.data(), s.size());
+    }
+
+    bool sendBytes(const void* buf, size_t len) {
         if (!connectIfNeeded()) return false;
-        const char* data = s.c_str();
-        size_t rem = s.size();
+        const char* data = static_cast<const char*>(buf);
+        size_t rem = len;
         while (rem > 0) {
             ssize_t n = ::send(sock_, data, rem, MSG_NOSIGNAL);
             if (n < 0) {
@@ -71,6 +77,9 @@ public:
         return true;
     }
 
+    int fd() const { return sock_; }
+    const std::string& host() const { return host_; }
+
 private:
     void closeSock() {
         if (sock_ >= 0) {
@@ -136,6 +145,10 @@ private:
     OpenCVPiano  piano_;
     HandDetector handDetector_;
     SocketSender sender_;
+    bool         useBinary_ = band_binary_requested();
+    uint32_t     seq_ = 0;
+    bool         useUdp_ = band_udp_requested();   // 노트만 UDP, 로그인은 TCP
+    BandUdpLink  udp_;
 
     // 현재 누르고 있는 "화이트키(0~6)" 집합
     std::set<int> currentlyPlayingWhiteKeys_;
@@ -166,12 +179,47 @@ private:
         } else {
             std::cerr << "[SOCK] login send failed\n";
         }
+        // BAND_PROTO=bin 이면 바이너리 레코드로 전송 (서버가 이 줄 다음 바이트부터 레코드로 해석)
+        if (ok && useBinary_) {
+            ok = sender_.sendLine(BAND_PROTO_HELLO_BIN);
+            if (ok) std::cout << "[SOCK] binary protocol requested\n";
+        }
+        // BAND_PROTO=udp 이면 노트는 UDP (서버 응답이 없으면 TCP 텍스트 유지)
+        if (ok && useUdp_ && !band_udp_open(sender_.fd(), sender_.host(), udp_))
+            std::cerr << "[SOCK] UDP channel unavailable -> TCP text\n";
         return ok;
     }
 
-    void sendPianoMsg(int whiteIdx) {
+    // frameUs: 이 타격을 판정한 카메라 프레임 시각 (0 = 키보드 테스트). 있으면 프레임 → 전송 지연을 함께 찍고,
+    // 이벤트의 클라이언트 시각으로도 보내 서버가 프레임부터 도착까지를 잰다 (0 이면 보내는 시각)
+    void sendPianoMsg(int whiteIdx, uint64_t frameUs = 0) {
         static const char* NOTE_NAME[7] = {"C","D","E","F","G","A","B"};
         if (whiteIdx < 0 || whiteIdx > 6) return;
+        const auto latency = [&] {
+            if (!frameUs) return std::string();
+            return "  frame->send " + std::to_string((band_now_us() - frameUs) / 1000.0).substr(0, 5) + " ms"
+                   + (handDetector_.fastCapture() ? " (driver ts)" : "");
+        };
+
+        if (udp_.ok()) {
+            // 유실돼도 재전송하지 않는다 (늦은 타격보다 빠진 타격이 낫다)
+            band_udp_send(udp_, BAND_INST_PIANO, uint8_t(whiteIdx), BAND_VELOCITY_DEFAULT, frameUs);
+            std::cout << "[TX] PIANO " << NOTE_NAME[whiteIdx] << " #" << udp_.seq << " (udp)" << latency() << "\n";
+            return;
+        }
+
+        if (useBinary_) {
+            // 화이트키 0~6 == BAND 피아노 노트 번호 (C D E F G A B)
+            BandEventRecord rec = band_make_event(BAND_INST_PIANO, uint8_t(whiteIdx),
+                                                  BAND_VELOCITY_DEFAULT, ++seq_,
+                                                  frameUs ? frameUs : band_now_us());
+            if (!sender_.sendBytes(&rec, sizeof(rec))) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                sender_.sendBytes(&rec, sizeof(rec));
+            }
+            std::cout << "[TX] PIANO " << NOTE_NAME[whiteIdx] << " #" << seq_ << latency() << "\n";
+            return;
+        }
 
         std::string msg = "[PIANO]" + std::string(NOTE_NAME[whiteIdx]) + "\n";
         if (!sender_.sendLine(msg)) {
@@ -179,7 +227,7 @@ private:
             sender_.sendLine(msg);
         }
 
-        std::cout << "[TX] " << msg; // 그대로 출력
+        std::cout << "[TX] [PIANO]" << NOTE_NAME[whiteIdx] << latency() << "\n";
     }
 
     void handleEvents() {
@@ -242,7 +290,7 @@ private:
                     newPlayingWhiteKeys.insert(whiteIdx);
                     if (currentlyPlayingWhiteKeys_.find(whiteIdx) == currentlyPlayingWhiteKeys_.end()) {
                         piano_.playKey(rawKeyIndex); // UI는 기존 인덱스로 강조
-                        sendPianoMsg(whiteIdx);
+                        sendPianoMsg(whiteIdx, handDetector_.frameTimeUs());
                     }
                 }
             }